@@ -0,0 +1,109 @@
+/*-------------------------------------------------------------------------
+Minimal Arduino API shim so NeoPixelBus can be built on a desktop host
+for profiling and benchmarking; it is not part of the library itself.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <thread>
+
+#include "Arduino.h"
+#include "SPI.h"
+
+SPIClass SPI;
+
+static std::chrono::microseconds s_advanced(0);
+static bool s_held = false;
+static std::chrono::steady_clock::time_point s_heldAt;
+
+static std::chrono::steady_clock::time_point startTime()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+
+void digitalWrite(uint8_t, uint8_t)
+{
+}
+
+int digitalRead(uint8_t)
+{
+    return LOW;
+}
+
+static std::chrono::steady_clock::duration elapsed()
+{
+    std::chrono::steady_clock::time_point now = s_held ? s_heldAt : std::chrono::steady_clock::now();
+    return now - startTime() + s_advanced;
+}
+
+uint32_t millis()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed()).count());
+}
+
+uint32_t micros()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed()).count());
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+void advanceMicros(uint32_t us)
+{
+    s_advanced += std::chrono::microseconds(us);
+}
+
+void holdClock(bool hold)
+{
+    if (hold && !s_held)
+    {
+        // not before the start, which is set on first use
+        startTime();
+        s_heldAt = std::chrono::steady_clock::now();
+    }
+    else if (!hold && s_held)
+    {
+        // the real time that passed while held isn't counted
+        s_advanced -= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_heldAt);
+    }
+    s_held = hold;
+}
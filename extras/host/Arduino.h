@@ -0,0 +1,90 @@
+/*-------------------------------------------------------------------------
+Minimal Arduino API shim so NeoPixelBus can be built on a desktop host
+for profiling and benchmarking; it is not part of the library itself.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+
+// hardware SPI pins of a typical board
+#define SCK  0
+#define MISO 1
+#define MOSI 2
+#define SS   3
+
+// there is no separate program memory on a host
+#define PROGMEM
+#define PGM_P const char*
+#ifndef PGM_VOID_P
+#define PGM_VOID_P const void*
+#endif
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+#define memcpy_P memcpy
+
+// there are no separate instruction or data memories on a host
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+// pins are accepted and ignored
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// time is measured from the first call into the shim
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// moves the clock forward without waiting, so code that times itself
+// can be stepped through quickly
+void advanceMicros(uint32_t us);
+
+// stops real time from moving the clock, so only advanceMicros does and
+// code that times itself can be checked to the microsecond
+void holdClock(bool hold);
@@ -0,0 +1,351 @@
+/*-------------------------------------------------------------------------
+HostFixtures holds what the host test and benchmark programs share:
+repeatable random data, the byte at a time reference kernels and a
+capture method that keeps what a bus sent.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstring>
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+
+// fills the buffer with repeatable pseudo random data
+inline void FillRandom(uint8_t* pData, size_t sizeData, uint32_t seed)
+{
+    for (size_t index = 0; index < sizeData; index++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        pData[index] = static_cast<uint8_t>(seed >> 24);
+    }
+}
+
+// a shader for NeoBuffer::Render that copies the color untouched
+template <typename T_COLOR_FEATURE> class CopyShader
+{
+public:
+    void Apply(uint16_t, uint8_t* pDest, const uint8_t* pSrc)
+    {
+        T_COLOR_FEATURE::applyPixelColor(pDest, 0, T_COLOR_FEATURE::retrievePixelColor(pSrc, 0));
+    }
+};
+
+// the byte at a time replicate and move the element classes used before
+// NeoElementsCopy, kept as the reference they are checked against
+template <size_t V_PIXELSIZE> class ElementsBytewise
+{
+public:
+    static const size_t PixelSize = V_PIXELSIZE;
+
+    static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        uint8_t* pEnd = pPixelDest + (count * V_PIXELSIZE);
+        while (pPixelDest < pEnd)
+        {
+            for (uint8_t iElement = 0; iElement < V_PIXELSIZE; iElement++)
+            {
+                *pPixelDest++ = pPixelSrc[iElement];
+            }
+        }
+    }
+
+    static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        uint8_t* pEnd = pPixelDest + (count * V_PIXELSIZE);
+        while (pPixelDest < pEnd)
+        {
+            *pPixelDest++ = *pPixelSrc++;
+        }
+    }
+
+    static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        uint8_t* pDestBack = pPixelDest + (count * V_PIXELSIZE);
+        const uint8_t* pSrcBack = pPixelSrc + (count * V_PIXELSIZE);
+        while (pDestBack > pPixelDest)
+        {
+            *--pDestBack = *--pSrcBack;
+        }
+    }
+};
+
+// the Ws2812x items of NeoEsp32RmtSpeedWs2812x, 25ns per RMT tick
+const uint32_t RmtBit0 = (34 << 16) | (1 << 15) | 16;
+const uint32_t RmtBit1 = (18 << 16) | (1 << 15) | 32;
+const uint16_t RmtDurationReset = 12000;
+const uint32_t RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+
+// the RMT ISR asks for half a memory block of items at a time
+const size_t RmtWantedNum = 32;
+
+// translates the whole data stream the way the RMT driver calls the translator
+template <typename T_TRANSLATE> size_t RmtTranslateAll(const uint8_t* pData,
+    size_t sizeData,
+    uint32_t* pItems,
+    T_TRANSLATE fnTranslate)
+{
+    size_t countItems = 0;
+    size_t index = 0;
+    while (index < sizeData)
+    {
+        size_t translated;
+        size_t items;
+
+        fnTranslate(pData + index, pItems + countItems, sizeData - index, RmtWantedNum, &translated, &items);
+        index += translated;
+        countItems += items;
+    }
+    return countItems;
+}
+
+// sends the data stream as it is, so the pixels sent can be read back
+class CaptureCopyEncoder
+{
+public:
+    static const size_t BytesPerDataByte = 1;
+
+    static void Encode(uint8_t* pSent, const uint8_t* pData, size_t sizeData)
+    {
+        memcpy(pSent, pData, sizeData);
+    }
+};
+
+// encodes like NeoEsp32I2sMethodBase, for what a re-encode costs
+class CaptureI2sEncoder
+{
+public:
+    static const size_t BytesPerDataByte = c_dmaBytesPerPixelBytes;
+
+    static void Encode(uint8_t* pSent, const uint8_t* pData, size_t sizeData)
+    {
+        NeoEsp32I2sByteEncoder::Encode(pSent, pData, sizeData);
+    }
+};
+
+// CaptureMethodBase is a host method that encodes the data stream into a
+// buffer of its own the way NeoEsp32I2sMethodBase fills its DMA buffer,
+// re-encoding only the dirty bytes, so what a bus sent can be checked.
+// It offers none of the optional method hooks; the classes below each
+// add one so every path of the bus can be taken
+template <typename T_ENCODER> class CaptureMethodBase : public NeoHostMethod
+{
+public:
+    CaptureMethodBase(uint8_t pin, uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
+        NeoHostMethod(pin, pixelCount, elementSize, settingsSize),
+        _sizeSettings(settingsSize),
+        _scale(NeoOutputScaleNone),
+        _rotation(0),
+        _holdSends(false),
+        _sending(false),
+        _callback(nullptr),
+        _context(nullptr)
+    {
+        _sent = new uint8_t[getDataSize() * T_ENCODER::BytesPerDataByte]();
+    }
+
+    ~CaptureMethodBase()
+    {
+        delete[] _sent;
+    }
+
+    bool IsReadyToUpdate() const
+    {
+        return !_sending;
+    }
+
+    void Update(bool maintainBufferConsistency)
+    {
+        Update(maintainBufferConsistency, 0, getDataSize());
+    }
+
+    void Update(bool maintainBufferConsistency, size_t dirtyOffset, size_t dirtySize)
+    {
+        NeoHostMethod::Update(maintainBufferConsistency);
+        _encode(_sent, dirtyOffset, dirtySize);
+        _sending = _holdSends;
+    }
+
+    // the encoded data stream as it was last sent
+    const uint8_t* Sent() const
+    {
+        return _sent;
+    }
+
+    // true when what was sent matches a full encode of the data
+    bool IsConsistent() const
+    {
+        size_t sizeSent = getDataSize() * T_ENCODER::BytesPerDataByte;
+        uint8_t* pReference = new uint8_t[sizeSent];
+
+        _encode(pReference, 0, getDataSize());
+        bool consistent = (memcmp(pReference, _sent, sizeSent) == 0);
+        delete[] pReference;
+        return consistent;
+    }
+
+    // keeps the method busy after each Update until Complete is called,
+    // like a DMA method whose send is on the wire
+    void HoldSends(bool hold)
+    {
+        _holdSends = hold;
+    }
+
+    // the end of send interrupt
+    void Complete()
+    {
+        _sending = false;
+        if (_callback != nullptr)
+        {
+            NeoShowCompleteCallback callback = _callback;
+
+            _callback = nullptr;
+            callback(_context);
+        }
+    }
+
+protected:
+    const size_t _sizeSettings;
+    uint16_t _scale;
+    size_t _rotation;
+    bool _holdSends;
+    bool _sending;
+    NeoShowCompleteCallback _callback;
+    void* _context;
+    uint8_t* _sent;
+
+    void _encode(uint8_t* pSent, size_t offset, size_t size) const
+    {
+        NeoEncodeRotated(getData(), offset, size, getDataSize(), _sizeSettings, _rotation, _scale,
+            [pSent](size_t offsetSent, const uint8_t* pBytes, size_t countBytes)
+            {
+                T_ENCODER::Encode(pSent + offsetSent * T_ENCODER::BytesPerDataByte, pBytes, countBytes);
+            });
+    }
+};
+
+template <typename T_ENCODER = CaptureCopyEncoder> class CaptureMethod :
+    public CaptureMethodBase<T_ENCODER>
+{
+public:
+    using CaptureMethodBase<T_ENCODER>::CaptureMethodBase;
+};
+
+// scales the pixels as it encodes them
+class CaptureScaleMethod : public CaptureMethodBase<CaptureCopyEncoder>
+{
+public:
+    using CaptureMethodBase<CaptureCopyEncoder>::CaptureMethodBase;
+
+    bool SetOutputScale(uint16_t scale)
+    {
+        _scale = scale;
+        return true;
+    }
+};
+
+// sends the pixels rotated as it encodes them
+class CaptureRotateMethod : public CaptureMethodBase<CaptureCopyEncoder>
+{
+public:
+    using CaptureMethodBase<CaptureCopyEncoder>::CaptureMethodBase;
+
+    bool SetOutputRotation(size_t rotation)
+    {
+        _rotation = rotation;
+        return true;
+    }
+};
+
+// signals the end of a send through the callback rather than being polled
+class CaptureSignalMethod : public CaptureMethodBase<CaptureCopyEncoder>
+{
+public:
+    using CaptureMethodBase<CaptureCopyEncoder>::CaptureMethodBase;
+
+    void SetCompleteCallback(NeoShowCompleteCallback callback, void* context)
+    {
+        _callback = callback;
+        _context = context;
+    }
+};
+
+// holds each update until the next one, like a lane of the parallel I2S
+// mux waiting on the other lanes, and isn't ready while one is held
+class CaptureStageMethod : public CaptureMethodBase<CaptureCopyEncoder>
+{
+public:
+    using CaptureMethodBase<CaptureCopyEncoder>::CaptureMethodBase;
+
+    const static bool DefersPixelRead = true;
+
+    bool IsReadyToUpdate() const
+    {
+        return !_staged && !_sending;
+    }
+
+    bool IsWriteDone() const
+    {
+        return !_sending;
+    }
+
+    void Update(bool maintainBufferConsistency)
+    {
+        if (!_staged)
+        {
+            _staged = true;
+            return;
+        }
+        _staged = false;
+        CaptureMethodBase<CaptureCopyEncoder>::Update(maintainBufferConsistency);
+    }
+
+private:
+    bool _staged = false;
+};
+
+// CaptureBus opens up any bus built on NeoPixelBus so its capture method
+// can be read and driven
+template <typename T_BUS> class CaptureBus : public T_BUS
+{
+public:
+    using T_BUS::T_BUS;
+
+    auto& Method()
+    {
+        return this->_method;
+    }
+
+    const auto& Method() const
+    {
+        return this->_method;
+    }
+
+    // the 16 bit gamma value of a byte, for NeoPixelGammaBus only
+    uint16_t GammaCorrect(size_t element, uint8_t value) const
+    {
+        return this->_tables[element].Correct(value);
+    }
+};
@@ -0,0 +1,921 @@
+/*-------------------------------------------------------------------------
+NeoPixelBusBenchmark is a host program that measures the per pixel cost of
+the library hot paths across color features and pixel counts.
+
+    NeoPixelBusBenchmark [filter]
+
+The output is CSV, one row per benchmark, feature and pixel count
+    benchmark,feature,pixels,iterations,ns_per_pixel
+so results can be stored per release and compared for regressions.
+The optional filter only runs benchmarks whose name contains it.
+Only the timing is reported here, NeoPixelBusTest checks the results.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+#include <NeoPixelAnimator.h>
+#include <NeoPixelBusFrameQueue.h>
+#include <NeoPixelPowerBus.h>
+#include <NeoPixelBrightnessBus.h>
+#include <NeoPixelGammaBus.h>
+#include <NeoPixelRingBus.h>
+
+#include "HostFixtures.h"
+
+const uint16_t PixelCounts[] = { 60, 300, 1000, 5000, 20000, 65535 };
+
+// each measurement runs for at least this long
+const std::chrono::nanoseconds MinimumRunTime = std::chrono::milliseconds(20);
+
+static const char* s_filter = nullptr;
+
+// accumulates results so the optimizer can't discard the measured work
+static volatile uint32_t s_sink;
+
+template <typename T> void Consume(const T& value)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    s_sink = s_sink + p[0];
+}
+
+static bool Enabled(const char* name)
+{
+    return (s_filter == nullptr || strstr(name, s_filter) != nullptr);
+}
+
+// runs fnIteration until MinimumRunTime has passed and reports the cost
+// of one pixel; fnIteration processes pixelCount pixels each call
+template <typename T_ITERATION> void Measure(const char* name,
+    const char* feature,
+    uint32_t pixelCount,
+    T_ITERATION fnIteration)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (!Enabled(name))
+    {
+        return;
+    }
+
+    // warm up caches and lazy allocations
+    fnIteration();
+
+    uint32_t iterations = 0;
+    Clock::duration elapsed;
+    Clock::time_point start = Clock::now();
+    do
+    {
+        fnIteration();
+        iterations++;
+        elapsed = Clock::now() - start;
+    } while (elapsed < MinimumRunTime);
+
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    printf("%s,%s,%u,%u,%.3f\n",
+        name,
+        feature,
+        static_cast<unsigned>(pixelCount),
+        static_cast<unsigned>(iterations),
+        ns / (static_cast<double>(iterations) * pixelCount));
+}
+
+template <typename T_COLOR_FEATURE> void BenchBus(const char* feature, uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> bus(pixelCount, 0);
+    bus.Begin();
+
+    Measure("SetPixelColor", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            bus.SetPixelColor(indexPixel, ColorObject(static_cast<uint8_t>(indexPixel)));
+        }
+    });
+
+    Measure("GetPixelColor", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            Consume(bus.GetPixelColor(indexPixel));
+        }
+    });
+
+    Measure("ClearTo", feature, pixelCount, [&]()
+    {
+        bus.ClearTo(ColorObject(static_cast<uint8_t>(s_sink)));
+    });
+
+    Measure("RotateLeft1", feature, pixelCount, [&]()
+    {
+        bus.RotateLeft(1);
+    });
+
+    uint16_t rotateCount = pixelCount / 4;
+    Measure("RotateRightQuarter", feature, pixelCount, [&]()
+    {
+        bus.RotateRight(rotateCount);
+    });
+
+    Measure("ShiftLeft1", feature, pixelCount, [&]()
+    {
+        bus.ShiftLeft(1);
+    });
+
+    Measure("ShiftRight1", feature, pixelCount, [&]()
+    {
+        bus.ShiftRight(1);
+    });
+
+    Measure("Show", feature, pixelCount, [&]()
+    {
+        bus.Dirty();
+        bus.Show();
+    });
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod, NeoFrameStats> busStats(pixelCount, 0);
+    busStats.Begin();
+
+    Measure("ShowFrameStats", feature, pixelCount, [&]()
+    {
+        busStats.Dirty();
+        busStats.Show();
+    });
+
+    // a single row image as wide as the bus
+    NeoBuffer<NeoBufferMethod<T_COLOR_FEATURE>> image(pixelCount, 1, NULL);
+    CopyShader<T_COLOR_FEATURE> bufferShader;
+
+    image.ClearTo(ColorObject(128));
+
+    Measure("NeoBuffer::Blt", feature, pixelCount, [&]()
+    {
+        image.Blt(bus, 0);
+    });
+
+    Measure("NeoBuffer::Render", feature, pixelCount, [&]()
+    {
+        image.Render(bus, bufferShader);
+    });
+
+    NeoBuffer<NeoBufferMethod<T_COLOR_FEATURE>> imageOther(pixelCount, 1, NULL);
+    FillRandom(NeoBufferContext<T_COLOR_FEATURE>(imageOther).Pixels, pixelCount * T_COLOR_FEATURE::PixelSize, pixelCount);
+
+    Measure("NeoBufferContext::BlendBuffers", feature, pixelCount, [&]()
+    {
+        NeoBufferContext<T_COLOR_FEATURE>::BlendBuffers(bus, image, imageOther, pixelCount, static_cast<uint8_t>(s_sink));
+    });
+
+    NeoDib<ColorObject> dib(pixelCount);
+    NeoShaderNop<ColorObject> dibShader;
+
+    dib.ClearTo(ColorObject(64));
+
+    Measure("NeoDib::Render", feature, pixelCount, [&]()
+    {
+        dib.Dirty();
+        dib.template Render<T_COLOR_FEATURE>(bus, dibShader);
+    });
+}
+
+// the in place rotates of NeoBuffer and NeoDib
+template <typename T_COLOR_FEATURE> void BenchRotate(const char* feature, uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoBuffer<NeoBufferMethod<T_COLOR_FEATURE>> image(pixelCount, 1, NULL);
+    NeoDib<ColorObject> dib(pixelCount);
+
+    uint16_t rotateCount = pixelCount / 4;
+    Measure("NeoBuffer::RotateRightQuarter", feature, pixelCount, [&]()
+    {
+        image.RotateRight(rotateCount);
+    });
+
+    Measure("NeoDib::RotateRightQuarter", feature, pixelCount, [&]()
+    {
+        dib.RotateRight(rotateCount);
+    });
+}
+
+// compares the cost of the span writes against per pixel SetPixelColor
+// for a whole frame of RGB triples, as a network receiver has
+template <typename T_COLOR_FEATURE> void BenchSetPixels(const char* feature, uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> bus(pixelCount, 0);
+    bus.Begin();
+
+    uint8_t* frame = new uint8_t[pixelCount * NeoRgbFeature::PixelSize];
+    ColorObject* colors = new ColorObject[pixelCount];
+    FillRandom(frame, pixelCount * NeoRgbFeature::PixelSize, pixelCount);
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        colors[indexPixel] = NeoRgbFeature::retrievePixelColor(frame, indexPixel);
+    }
+
+    NeoPixelBusInterface<T_COLOR_FEATURE>& busInterface = bus;
+    Measure("SetPixelColorFrame", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            busInterface.SetPixelColor(indexPixel, NeoRgbFeature::retrievePixelColor(frame, indexPixel));
+        }
+    });
+
+    Measure("SetPixels", feature, pixelCount, [&]()
+    {
+        bus.SetPixels(0, colors, pixelCount);
+    });
+
+    Measure("SetPixelsRaw", feature, pixelCount, [&]()
+    {
+        bus.template SetPixelsRaw<NeoRgbFeature>(0, frame, pixelCount);
+    });
+
+    delete[] colors;
+    delete[] frame;
+}
+
+template <typename T_ELEMENTS> void BenchElementsMeasure(const char* name,
+    const char* feature,
+    uint16_t pixelCount,
+    uint8_t* pPixels)
+{
+    char nameFull[64];
+
+    snprintf(nameFull, sizeof(nameFull), "%s::replicatePixel", name);
+    Measure(nameFull, feature, pixelCount, [&]()
+    {
+        T_ELEMENTS::replicatePixel(pPixels + T_ELEMENTS::PixelSize, pPixels, pixelCount - 1);
+        Consume(pPixels[0]);
+    });
+
+    snprintf(nameFull, sizeof(nameFull), "%s::movePixelsInc", name);
+    Measure(nameFull, feature, pixelCount, [&]()
+    {
+        T_ELEMENTS::movePixelsInc(pPixels, pPixels + T_ELEMENTS::PixelSize, pixelCount - 1);
+        Consume(pPixels[0]);
+    });
+
+    snprintf(nameFull, sizeof(nameFull), "%s::movePixelsDec", name);
+    Measure(nameFull, feature, pixelCount, [&]()
+    {
+        T_ELEMENTS::movePixelsDec(pPixels + T_ELEMENTS::PixelSize, pPixels, pixelCount - 1);
+        Consume(pPixels[0]);
+    });
+}
+
+// the replicate and overlapping moves of the feature against the byte at
+// a time reference
+template <typename T_COLOR_FEATURE> void BenchElements(const char* feature, uint16_t pixelCount)
+{
+    size_t sizePixels = pixelCount * T_COLOR_FEATURE::PixelSize;
+    uint8_t* pPixels = new uint8_t[sizePixels];
+
+    FillRandom(pPixels, sizePixels, pixelCount);
+
+    BenchElementsMeasure<ElementsBytewise<T_COLOR_FEATURE::PixelSize>>("Bytewise", feature, pixelCount, pPixels);
+    BenchElementsMeasure<T_COLOR_FEATURE>("NeoElementsCopy", feature, pixelCount, pPixels);
+
+    delete[] pPixels;
+}
+
+// a rainbow across the pixels, converted every frame
+void BenchHue(uint16_t pixelCount)
+{
+    HsbColor* hsb = new HsbColor[pixelCount];
+    HslColor* hsl = new HslColor[pixelCount];
+    HsbColor8* hsb8 = new HsbColor8[pixelCount];
+    HslColor8* hsl8 = new HslColor8[pixelCount];
+    RgbColor* result = new RgbColor[pixelCount];
+
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        uint8_t hue = static_cast<uint8_t>(indexPixel * 256 / pixelCount);
+
+        hsb[indexPixel] = HsbColor(hue / 256.0f, 1.0f, 0.5f);
+        hsl[indexPixel] = HslColor(hue / 256.0f, 1.0f, 0.25f);
+        hsb8[indexPixel] = HsbColor8(hue, 255, 128);
+        hsl8[indexPixel] = HslColor8(hue, 255, 64);
+    }
+
+    Measure("HsbColor", "RgbColor", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = hsb[indexPixel];
+        }
+        Consume(result[0]);
+    });
+
+    Measure("HsbColor8", "RgbColor", pixelCount, [&]()
+    {
+        HsbColor8::ConvertToRgb(result, hsb8, pixelCount);
+        Consume(result[0]);
+    });
+
+    Measure("HslColor", "RgbColor", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = hsl[indexPixel];
+        }
+        Consume(result[0]);
+    });
+
+    Measure("HslColor8", "RgbColor", pixelCount, [&]()
+    {
+        HslColor8::ConvertToRgb(result, hsl8, pixelCount);
+        Consume(result[0]);
+    });
+
+    float* huesFloat = new float[pixelCount];
+    uint16_t* hues = new uint16_t[pixelCount];
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        hues[indexPixel] = static_cast<uint16_t>(indexPixel * 997);
+        huesFloat[indexPixel] = hues[indexPixel] / 65536.0f;
+    }
+
+    Measure("NeoHueBlendShortestDistance::HueBlendFloat", "HslColor", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            huesFloat[indexPixel] = NeoHueBlendShortestDistance::HueBlend(huesFloat[indexPixel], 0.6f, 0.25f);
+        }
+        Consume(huesFloat[0]);
+    });
+
+    Measure("NeoHueBlendShortestDistance::HueBlend", "HslColor8", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            hues[indexPixel] = NeoHueBlendShortestDistance::HueBlend(hues[indexPixel], static_cast<uint16_t>(39322), static_cast<uint16_t>(16384));
+        }
+        Consume(hues[0]);
+    });
+
+    Measure("NeoHueBlendLongestDistance::HueBlendFloat", "HslColor", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            huesFloat[indexPixel] = NeoHueBlendLongestDistance::HueBlend(huesFloat[indexPixel], 0.6f, 0.25f);
+        }
+        Consume(huesFloat[0]);
+    });
+
+    Measure("NeoHueBlendLongestDistance::HueBlend16", "HslColor8", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            hues[indexPixel] = NeoHueBlendLongestDistance::HueBlend16(hues[indexPixel], static_cast<uint16_t>(39322), static_cast<uint16_t>(16384));
+        }
+        Consume(hues[0]);
+    });
+
+    HslColor8 target(153, 200, 100);
+    Measure("HslColor8::LinearBlend", "HslColor8", pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            hsl8[indexPixel] = HslColor8::LinearBlend<NeoHueBlendShortestDistance>(hsl8[indexPixel], target, 64);
+        }
+        Consume(hsl8[0]);
+    });
+
+    delete[] huesFloat;
+    delete[] hues;
+    delete[] hsb;
+    delete[] hsl;
+    delete[] hsb8;
+    delete[] hsl8;
+    delete[] result;
+}
+
+template <typename T_COLOR_OBJECT> void BenchColor(const char* feature, uint16_t pixelCount)
+{
+    T_COLOR_OBJECT* left = new T_COLOR_OBJECT[pixelCount];
+    T_COLOR_OBJECT* right = new T_COLOR_OBJECT[pixelCount];
+    T_COLOR_OBJECT* result = new T_COLOR_OBJECT[pixelCount];
+
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        left[indexPixel] = T_COLOR_OBJECT(static_cast<uint8_t>(indexPixel));
+        right[indexPixel] = T_COLOR_OBJECT(static_cast<uint8_t>(255 - indexPixel));
+    }
+
+    float progress = 0.37f;
+
+    Measure("LinearBlend", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = T_COLOR_OBJECT::LinearBlend(left[indexPixel], right[indexPixel], progress);
+        }
+        Consume(result[0]);
+    });
+
+    Measure("BilinearBlend", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = T_COLOR_OBJECT::BilinearBlend(left[indexPixel],
+                right[indexPixel],
+                right[indexPixel],
+                left[indexPixel],
+                progress,
+                1.0f - progress);
+        }
+        Consume(result[0]);
+    });
+
+    uint8_t progress8 = static_cast<uint8_t>(progress * 255);
+    uint16_t progress16 = static_cast<uint16_t>(progress * 65535);
+
+    Measure("LinearBlend8", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = T_COLOR_OBJECT::LinearBlend8(left[indexPixel], right[indexPixel], progress8);
+        }
+        Consume(result[0]);
+    });
+
+    Measure("LinearBlend16", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = T_COLOR_OBJECT::LinearBlend16(left[indexPixel], right[indexPixel], progress16);
+        }
+        Consume(result[0]);
+    });
+
+    Measure("BilinearBlend8", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = T_COLOR_OBJECT::BilinearBlend8(left[indexPixel],
+                right[indexPixel],
+                right[indexPixel],
+                left[indexPixel],
+                progress8,
+                static_cast<uint8_t>(255 - progress8));
+        }
+        Consume(result[0]);
+    });
+
+    NeoGamma<NeoGammaTableMethod> gammaTable;
+    NeoGamma<NeoGammaEquationMethod> gammaEquation;
+
+    Measure("NeoGammaTableMethod::Correct", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = gammaTable.Correct(left[indexPixel]);
+        }
+        Consume(result[0]);
+    });
+
+    Measure("NeoGammaEquationMethod::Correct", feature, pixelCount, [&]()
+    {
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            result[indexPixel] = gammaEquation.Correct(left[indexPixel]);
+        }
+        Consume(result[0]);
+    });
+
+    delete[] left;
+    delete[] right;
+    delete[] result;
+}
+
+template <typename T_ENCODER> void BenchI2sEncoder(const char* name,
+    const char* feature,
+    uint16_t pixelCount,
+    size_t pixelSize)
+{
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* pData = new uint8_t[sizeData];
+    uint32_t* pDma = new uint32_t[sizeData];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    Measure(name, feature, pixelCount, [&]()
+    {
+        T_ENCODER::Encode(reinterpret_cast<uint8_t*>(pDma), pData, sizeData);
+        Consume(pDma[0]);
+    });
+
+    delete[] pData;
+    delete[] pDma;
+}
+
+// the ESP8266 DMA and UART encoders
+void BenchEsp8266Encoders(const char* feature, uint16_t pixelCount, size_t pixelSize)
+{
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* pData = new uint8_t[sizeData];
+    uint32_t* pDma = new uint32_t[sizeData];
+    uint8_t* pUart = new uint8_t[sizeData * 4];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    Measure("NeoEsp8266DmaEncoder::Encode", feature, pixelCount, [&]()
+    {
+        NeoEsp8266DmaEncoder<NeoEsp8266DmaSpeedBase>::Encode(reinterpret_cast<uint8_t*>(pDma), pData, sizeData);
+        Consume(pDma[0]);
+    });
+
+    Measure("NeoEsp8266UartEncoder::Encode", feature, pixelCount, [&]()
+    {
+        NeoEsp8266UartEncoder::Encode(pUart, pData, sizeData);
+        Consume(pUart[0]);
+    });
+
+    delete[] pData;
+    delete[] pDma;
+    delete[] pUart;
+}
+
+// encodes one data stream per lane; the cost is reported per pixel of all lanes
+template <typename T_LANEWORD, typename T_TRANSPOSE> void BenchI2sParallelEncoder(const char* name,
+    const char* feature,
+    uint16_t pixelCount,
+    size_t pixelSize)
+{
+    typedef NeoEsp32I2sParallelEncoder<T_LANEWORD, T_TRANSPOSE> T_ENCODER;
+
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* laneData[T_ENCODER::LaneCount];
+    size_t laneSizes[T_ENCODER::LaneCount];
+    uint32_t* pDma = new uint32_t[sizeData * T_ENCODER::DmaBytesPerDataByte / sizeof(uint32_t)];
+
+    for (uint8_t lane = 0; lane < T_ENCODER::LaneCount; lane++)
+    {
+        laneData[lane] = new uint8_t[sizeData];
+        laneSizes[lane] = sizeData;
+        FillRandom(laneData[lane], sizeData, pixelCount + lane);
+    }
+
+    Measure(name, feature, pixelCount * T_ENCODER::LaneCount, [&]()
+    {
+        T_ENCODER::Encode(reinterpret_cast<uint8_t*>(pDma), laneData, laneSizes, sizeData);
+        Consume(pDma[0]);
+    });
+
+    for (uint8_t lane = 0; lane < T_ENCODER::LaneCount; lane++)
+    {
+        delete[] laneData[lane];
+    }
+    delete[] pDma;
+}
+
+void BenchRmtTranslators(const char* feature, uint16_t pixelCount, size_t pixelSize)
+{
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* pData = new uint8_t[sizeData];
+    uint32_t* pItems = new uint32_t[sizeData * 8];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    auto translateBits = [](const uint8_t* src, uint32_t* dest, size_t src_size, size_t wanted_num, size_t* translated_size, size_t* item_num)
+    {
+        NeoEsp32RmtBitTranslator::Translate(src, dest, src_size, wanted_num, translated_size, item_num,
+            RmtBit0, RmtBit1, RmtDurationReset);
+    };
+    auto translateNibbles = [](const uint8_t* src, uint32_t* dest, size_t src_size, size_t wanted_num, size_t* translated_size, size_t* item_num)
+    {
+        NeoEsp32RmtNibbleTranslator::Translate(src, dest, src_size, wanted_num, translated_size, item_num,
+            RmtNibbleItems, RmtDurationReset);
+    };
+
+    Measure("NeoEsp32RmtBitTranslator::Translate", feature, pixelCount, [&]()
+    {
+        Consume(RmtTranslateAll(pData, sizeData, pItems, translateBits));
+    });
+
+    Measure("NeoEsp32RmtNibbleTranslator::Translate", feature, pixelCount, [&]()
+    {
+        Consume(RmtTranslateAll(pData, sizeData, pItems, translateNibbles));
+    });
+
+    delete[] pData;
+    delete[] pItems;
+}
+
+// the transpose kernel over random lane bytes; the cost is reported per
+// lane byte
+template <typename T_TRANSPOSE, typename T_LANEWORD> void BenchTranspose(const char* name, uint16_t pixelCount)
+{
+    const uint8_t laneCount = NeoBitTransposeReference<T_LANEWORD>::LaneCount;
+
+    size_t sizeData = pixelCount * laneCount;
+    uint8_t* pData = new uint8_t[sizeData];
+    T_LANEWORD* pBits = new T_LANEWORD[pixelCount * 8];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    Measure(name, (laneCount == 8) ? "X8" : "X16", sizeData, [&]()
+    {
+        for (uint16_t index = 0; index < pixelCount; index++)
+        {
+            T_TRANSPOSE::Transpose(pBits + index * 8, pData + index * laneCount);
+        }
+        Consume(pBits[0]);
+    });
+
+    delete[] pData;
+    delete[] pBits;
+}
+
+void BenchTransposes(uint16_t pixelCount)
+{
+    BenchTranspose<NeoBitTransposeReference<uint8_t>, uint8_t>("NeoBitTransposeReference::Transpose", pixelCount);
+    BenchTranspose<NeoBitTransposeSwar<uint8_t>, uint8_t>("NeoBitTransposeSwar::Transpose", pixelCount);
+    BenchTranspose<NeoBitTransposeLut<uint8_t>, uint8_t>("NeoBitTransposeLut::Transpose", pixelCount);
+
+    BenchTranspose<NeoBitTransposeReference<uint16_t>, uint16_t>("NeoBitTransposeReference::Transpose", pixelCount);
+    BenchTranspose<NeoBitTransposeSwar<uint16_t>, uint16_t>("NeoBitTransposeSwar::Transpose", pixelCount);
+    BenchTranspose<NeoBitTransposeLut<uint16_t>, uint16_t>("NeoBitTransposeLut::Transpose", pixelCount);
+}
+
+// compares a Show after a full change against a Show after one pixel
+// changed, which only re-encodes that pixel
+template <typename T_COLOR_FEATURE> void BenchDirtyRange(const char* feature, uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, CaptureMethod<CaptureI2sEncoder>> bus(pixelCount, 0);
+    bus.Begin();
+    bus.ClearTo(ColorObject(32));
+    bus.Show();
+
+    Measure("ShowDirtyAll", feature, pixelCount, [&]()
+    {
+        bus.Dirty();
+        bus.Show();
+    });
+
+    uint16_t indexPixel = 0;
+    Measure("ShowDirtyPixel", feature, pixelCount, [&]()
+    {
+        indexPixel = (indexPixel + 7) % pixelCount;
+        bus.SetPixelColor(indexPixel, ColorObject(static_cast<uint8_t>(indexPixel)));
+        bus.Show();
+    });
+}
+
+// one slot per pixel, as effects that animate each pixel allocate
+const uint16_t AnimatorSlots = 3000;
+
+// the cost of an update for each animation running, with few or all
+// of the slots animating, and of finding a slot when few are free
+void BenchAnimator()
+{
+    auto fnConsume = [](const AnimationParam& param)
+    {
+        Consume(param.index);
+    };
+
+    NeoPixelAnimator sparse(AnimatorSlots, 1, NeoAnimatorClock_Micros);
+    for (uint16_t index = 0; index < AnimatorSlots; index += 100)
+    {
+        sparse.StartAnimation(index, 0xf0000000, fnConsume);
+    }
+
+    Measure("NeoPixelAnimator::UpdateAnimations", "sparse", AnimatorSlots / 100, [&]()
+    {
+        advanceMicros(1);
+        sparse.UpdateAnimations();
+    });
+
+    NeoPixelAnimator dense(AnimatorSlots, 1, NeoAnimatorClock_Micros);
+    for (uint16_t index = 0; index < AnimatorSlots; index++)
+    {
+        dense.StartAnimation(index, 0xf0000000, fnConsume);
+    }
+
+    Measure("NeoPixelAnimator::UpdateAnimations", "dense", AnimatorSlots, [&]()
+    {
+        advanceMicros(1);
+        dense.UpdateAnimations();
+    });
+
+    // only the last slot is free
+    dense.StopAnimation(AnimatorSlots - 1);
+    advanceMicros(1);
+    dense.UpdateAnimations();
+
+    Measure("NeoPixelAnimator::NextAvailableAnimation", "dense", 1, [&]()
+    {
+        uint16_t indexAnimation = 0;
+        dense.NextAvailableAnimation(&indexAnimation);
+        Consume(indexAnimation);
+    });
+}
+
+
+// the cost of NeoPixelBrightnessBus::Show on the wire path and the dim
+// and restore path
+template <typename T_COLOR_FEATURE, typename T_METHOD> void BenchBrightness(const char* name,
+    const char* feature,
+    uint16_t pixelCount)
+{
+    NeoPixelBrightnessBus<T_COLOR_FEATURE, T_METHOD> bus(pixelCount, 0);
+    bus.Begin();
+    FillRandom(bus.Pixels(), bus.PixelsSize(), pixelCount);
+
+    bus.SetBrightness(128);
+    Measure(name, feature, pixelCount, [&]()
+    {
+        bus.Dirty();
+        bus.Show();
+    });
+}
+
+template <typename T_COLOR_FEATURE> void BenchGamma(const char* feature, uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelGammaBus<T_COLOR_FEATURE, CaptureMethod<>> bus(pixelCount, 0);
+    bus.Begin();
+    bus.SetWhiteBalance(ColorObject(255, 224, 192));
+    FillRandom(bus.Pixels(), bus.PixelsSize(), pixelCount);
+
+    Measure("NeoPixelGammaBus::Show", feature, pixelCount, [&]()
+    {
+        bus.Show();
+    });
+}
+
+// compares rotating the pixels of a plain bus against rotating what a
+// NeoPixelRingBus sends
+template <typename T_COLOR_FEATURE> void BenchRing(const char* feature, uint16_t pixelCount)
+{
+    NeoPixelBus<T_COLOR_FEATURE, CaptureRotateMethod> plain(pixelCount, 0);
+    NeoPixelRingBus<T_COLOR_FEATURE, CaptureRotateMethod> ring(pixelCount, 0);
+    plain.Begin();
+    ring.Begin();
+
+    Measure("RotateLeft1Show", feature, pixelCount, [&]()
+    {
+        plain.RotateLeft(1);
+        plain.Show();
+    });
+
+    Measure("NeoPixelRingBus::RotateLeft1Show", feature, pixelCount, [&]()
+    {
+        ring.RotateLeft(1);
+        ring.Show();
+    });
+}
+
+// compares a full walk for the current against the running total of
+// NeoPixelPowerBus, and the cost of a Show limited to a budget
+template <typename T_COLOR_FEATURE> void BenchPower(const char* feature,
+    uint16_t pixelCount,
+    const typename T_COLOR_FEATURE::ColorObject::SettingsObject& settings)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelPowerBus<T_COLOR_FEATURE, CaptureMethod<>> bus(pixelCount, 0, settings);
+    bus.Begin();
+    FillRandom(bus.Pixels(), bus.PixelsSize(), pixelCount);
+
+    Measure("CalcTotalMilliAmpere", feature, pixelCount, [&]()
+    {
+        Consume(bus.CalcTotalMilliAmpere(settings));
+    });
+
+    Measure("NeoPixelPowerBus::CalcTotalMilliAmpere", feature, pixelCount, [&]()
+    {
+        bus.SetPixelColor(pixelCount / 2, ColorObject(static_cast<uint8_t>(s_sink)));
+        Consume(bus.CalcTotalMilliAmpere());
+    });
+
+    bus.SetPowerBudget(bus.CalcTotalMilliAmpere() / 2);
+    Measure("NeoPixelPowerBus::ShowLimited", feature, pixelCount, [&]()
+    {
+        bus.Dirty();
+        bus.Show();
+    });
+}
+
+// compares the render side cost of Show against a plain bus
+template <typename T_COLOR_FEATURE> void BenchFrameQueue(const char* feature, uint16_t pixelCount)
+{
+    NeoPixelBusFrameQueue<T_COLOR_FEATURE, NeoHostMethod> queue(pixelCount, 0);
+    queue.Begin();
+
+    Measure("NeoPixelBusFrameQueue::Show", feature, pixelCount, [&]()
+    {
+        queue.Show(false);
+    });
+
+    Measure("NeoPixelBusFrameQueue::Process", feature, pixelCount, [&]()
+    {
+        queue.Show(false);
+        queue.Process();
+    });
+}
+
+void BenchEncoders(const char* feature, uint16_t pixelCount, size_t pixelSize)
+{
+    BenchI2sEncoder<NeoEsp32I2sNibbleEncoder>("NeoEsp32I2sNibbleEncoder::Encode", feature, pixelCount, pixelSize);
+    BenchI2sEncoder<NeoEsp32I2sByteEncoder>("NeoEsp32I2sByteEncoder::Encode", feature, pixelCount, pixelSize);
+    BenchRmtTranslators(feature, pixelCount, pixelSize);
+    BenchEsp8266Encoders(feature, pixelCount, pixelSize);
+    BenchI2sParallelEncoder<uint8_t, NeoBitTransposeSwar<uint8_t>>("NeoEsp32I2sParallelEncoder<X8>::Encode", feature, pixelCount, pixelSize);
+    BenchI2sParallelEncoder<uint16_t, NeoBitTransposeSwar<uint16_t>>("NeoEsp32I2sParallelEncoder<X16>::Encode", feature, pixelCount, pixelSize);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        s_filter = argv[1];
+    }
+
+    printf("benchmark,feature,pixels,iterations,ns_per_pixel\n");
+
+    BenchAnimator();
+
+    for (uint16_t pixelCount : PixelCounts)
+    {
+        BenchBus<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+        BenchBus<NeoGrbwFeature>("NeoGrbwFeature", pixelCount);
+        BenchBus<DotStarBgrFeature>("DotStarBgrFeature", pixelCount);
+
+        BenchRotate<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+        BenchRotate<NeoGrbwFeature>("NeoGrbwFeature", pixelCount);
+
+        BenchSetPixels<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+        BenchSetPixels<NeoBrgFeature>("NeoBrgFeature", pixelCount);
+        BenchSetPixels<DotStarBgrFeature>("DotStarBgrFeature", pixelCount);
+
+        BenchElements<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+        BenchElements<NeoGrbwFeature>("NeoGrbwFeature", pixelCount);
+        BenchElements<DotStarBgrFeature>("DotStarBgrFeature", pixelCount);
+
+        BenchDirtyRange<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+
+        BenchRing<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+        BenchRing<NeoWrgbTm1814Feature>("NeoWrgbTm1814Feature", pixelCount);
+        BenchDirtyRange<NeoWrgbTm1814Feature>("NeoWrgbTm1814Feature", pixelCount);
+
+        BenchFrameQueue<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+
+        BenchPower<NeoGrbFeature>("NeoGrbFeature", pixelCount, NeoRgbCurrentSettings(160, 160, 160));
+        BenchPower<NeoGrbwFeature>("NeoGrbwFeature", pixelCount, NeoRgbwCurrentSettings(160, 160, 160, 200));
+
+        BenchBrightness<NeoGrbFeature, CaptureScaleMethod>("NeoPixelBrightnessBus::Show", "NeoGrbFeature", pixelCount);
+        BenchBrightness<NeoGrbFeature, CaptureMethod<>>("NeoPixelBrightnessBus::ShowDimmed", "NeoGrbFeature", pixelCount);
+        BenchBrightness<DotStarBgrFeature, CaptureScaleMethod>("NeoPixelBrightnessBus::Show", "DotStarBgrFeature", pixelCount);
+
+        BenchGamma<NeoGrbFeature>("NeoGrbFeature", pixelCount);
+        BenchGamma<NeoGrbwFeature>("NeoGrbwFeature", pixelCount);
+        BenchGamma<DotStarBgrFeature>("DotStarBgrFeature", pixelCount);
+
+        BenchColor<RgbColor>("RgbColor", pixelCount);
+        BenchColor<RgbwColor>("RgbwColor", pixelCount);
+        BenchHue(pixelCount);
+
+        BenchEncoders("Neo3Elements", pixelCount, Neo3Elements::PixelSize);
+        BenchEncoders("Neo4Elements", pixelCount, Neo4Elements::PixelSize);
+
+        BenchTransposes(pixelCount);
+    }
+
+    return 0;
+}
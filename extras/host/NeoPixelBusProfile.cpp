@@ -0,0 +1,123 @@
+/*-------------------------------------------------------------------------
+NeoPixelBusProfile is a host program that runs a typical render loop over
+the library templates so it can be run under perf, valgrind or gprof.
+
+    NeoPixelBusProfile [pixelCount] [frameCount]
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <cstdio>
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+#include <NeoPixelBrightnessBus.h>
+#include <NeoPixelAnimator.h>
+
+const uint16_t TileWidth = 16;
+const uint16_t TileHeight = 16;
+
+int main(int argc, char* argv[])
+{
+    uint16_t pixelCount = (argc > 1) ? static_cast<uint16_t>(atoi(argv[1])) : 1024;
+    uint32_t frameCount = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : 1000;
+
+    NeoPixelBus<NeoGrbFeature, NeoHostMethod> strip(pixelCount, 2);
+    NeoPixelBus<NeoGrbwFeature, NeoHostMethod> stripRgbw(pixelCount, 3);
+    NeoPixelBrightnessBus<NeoGrbFeature, NeoHostMethod> stripBright(pixelCount, 4);
+    NeoPixelBus<DotStarBgrFeature, DotStarMethod> dotStar(pixelCount, 5, 6);
+
+    NeoTopology<ColumnMajorAlternatingLayout> topo(TileWidth, TileHeight);
+    NeoMosaic<ColumnMajorAlternatingLayout> mosaic(TileWidth, TileHeight, 2, 2);
+    NeoBuffer<NeoBufferMethod<NeoGrbFeature>> image(TileWidth, TileHeight, NULL);
+    NeoDib<RgbColor> dib(pixelCount);
+    NeoShaderNop<RgbColor> shader;
+    NeoGamma<NeoGammaTableMethod> gamma;
+    NeoPixelAnimator animations(4);
+
+    strip.Begin();
+    stripRgbw.Begin();
+    stripBright.Begin();
+    dotStar.Begin();
+
+    auto layoutMap = [&](int16_t x, int16_t y) -> uint16_t
+    {
+        return mosaic.Map(x, y);
+    };
+
+    for (uint16_t indexAnim = 0; indexAnim < 4; indexAnim++)
+    {
+        animations.StartAnimation(indexAnim, 1000, [&](const AnimationParam& param)
+        {
+            RgbColor color = RgbColor::LinearBlend(RgbColor(255, 0, 0), RgbColor(0, 0, 255), param.progress);
+            strip.SetPixelColor(param.index, color);
+        });
+    }
+
+    uint32_t checksum = 0;
+
+    for (uint32_t frame = 0; frame < frameCount; frame++)
+    {
+        uint8_t level = static_cast<uint8_t>(frame);
+        RgbColor color(level, 255 - level, level / 2);
+
+        strip.ClearTo(0);
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            strip.SetPixelColor(indexPixel, gamma.Correct(RgbColor::LinearBlend(color, RgbColor(0), indexPixel / float(pixelCount))));
+        }
+        strip.RotateLeft(1);
+        strip.ShiftRight(1);
+
+        stripRgbw.ClearTo(RgbwColor(color.R, color.G, color.B, level));
+        stripBright.SetBrightness(level);
+        stripBright.ClearTo(color);
+        dotStar.ClearTo(color);
+
+        image.ClearTo(color);
+        image.SetPixelColor(frame % TileWidth, 0, RgbColor(HslColor(level / 255.0f, 1.0f, 0.5f)));
+        image.Blt(strip, 0);
+        image.Blt(strip, 0, 0, layoutMap);
+
+        dib.ClearTo(color);
+        dib.Render<NeoGrbFeature>(strip, shader);
+        strip.SetPixelColor(topo.Map(frame % TileWidth, frame % TileHeight), color);
+
+        animations.UpdateAnimations();
+
+        strip.Show();
+        stripRgbw.Show();
+        stripBright.Show();
+        dotStar.Show();
+
+        checksum += strip.GetPixelColor(frame % pixelCount).R;
+    }
+
+    // printing the checksum keeps the optimizer from discarding the work
+    printf("frames %u, pixels %u, checksum %u\n",
+        static_cast<unsigned>(frameCount),
+        static_cast<unsigned>(pixelCount),
+        static_cast<unsigned>(checksum));
+
+    return 0;
+}
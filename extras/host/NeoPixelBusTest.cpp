@@ -0,0 +1,1461 @@
+/*-------------------------------------------------------------------------
+NeoPixelBusTest is a host program that checks the library hot paths
+against their reference implementations, and the buses against what a
+capture method was sent, across color features and pixel counts.
+
+    NeoPixelBusTest [filter]
+
+Each failed check is reported on stderr and the exit code is non zero,
+so it can be run by ctest.  The optional filter only runs the groups of
+checks (Bus, Animator, Color, Elements, Ring, Power, Brightness, Gamma,
+Encoder) whose name contains it.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <Arduino.h>
+#include <NeoPixelBus.h>
+#include <NeoPixelAnimator.h>
+#include <NeoPixelBusFrameQueue.h>
+#include <NeoPixelPowerBus.h>
+#include <NeoPixelBrightnessBus.h>
+#include <NeoPixelGammaBus.h>
+#include <NeoPixelRingBus.h>
+
+#include "HostFixtures.h"
+
+const uint16_t PixelCounts[] = { 60, 300, 1000, 5000, 20000, 65535 };
+
+static const char* s_filter = nullptr;
+static uint32_t s_checkCount = 0;
+static uint32_t s_failedCount = 0;
+
+static bool Enabled(const char* name)
+{
+    return (s_filter == nullptr || strstr(name, s_filter) != nullptr);
+}
+
+static void Check(const char* name, bool passed)
+{
+    s_checkCount++;
+    if (!passed)
+    {
+        fprintf(stderr, "check failed: %s\n", name);
+        s_failedCount++;
+    }
+}
+
+// checks NeoBuffer::Render and NeoBufferContext::BlendBuffers into a bus
+template <typename T_COLOR_FEATURE> void TestBuffer(uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> bus(pixelCount, 0);
+    bus.Begin();
+
+    // a single row image as wide as the bus
+    NeoBuffer<NeoBufferMethod<T_COLOR_FEATURE>> image(pixelCount, 1, NULL);
+    CopyShader<T_COLOR_FEATURE> shader;
+
+    FillRandom(NeoBufferContext<T_COLOR_FEATURE>(image).Pixels, pixelCount * T_COLOR_FEATURE::PixelSize, pixelCount + 2);
+    image.Render(bus, shader);
+    bool passed = true;
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        passed = passed && (bus.GetPixelColor(indexPixel) ==
+            T_COLOR_FEATURE::retrievePixelColor(NeoBufferContext<T_COLOR_FEATURE>(image).Pixels, indexPixel));
+    }
+    Check("NeoBuffer::Render", passed);
+
+    NeoBuffer<NeoBufferMethod<T_COLOR_FEATURE>> imageOther(pixelCount, 1, NULL);
+    image.ClearTo(ColorObject(128));
+    FillRandom(NeoBufferContext<T_COLOR_FEATURE>(imageOther).Pixels, pixelCount * T_COLOR_FEATURE::PixelSize, pixelCount);
+
+    NeoBufferContext<T_COLOR_FEATURE>::BlendBuffers(bus, image, imageOther, pixelCount, static_cast<uint8_t>(77));
+    passed = true;
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        passed = passed && (bus.GetPixelColor(indexPixel) == ColorObject::LinearBlend8(
+            T_COLOR_FEATURE::retrievePixelColor(NeoBufferContext<T_COLOR_FEATURE>(image).Pixels, indexPixel),
+            T_COLOR_FEATURE::retrievePixelColor(NeoBufferContext<T_COLOR_FEATURE>(imageOther).Pixels, indexPixel),
+            static_cast<uint8_t>(77)));
+    }
+    Check("NeoBufferContext::BlendBuffers", passed);
+}
+
+// checks the in place rotates of the bus, NeoBuffer and NeoDib against
+// the two copies a rotate amounts to, for counts up to the whole length
+template <typename T_COLOR_FEATURE> void TestRotate(uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> bus(pixelCount, 0);
+    NeoBuffer<NeoBufferMethod<T_COLOR_FEATURE>> image(pixelCount, 1, NULL);
+    NeoDib<ColorObject> dib(pixelCount);
+    bus.Begin();
+
+    uint8_t* pImagePixels = NeoBufferContext<T_COLOR_FEATURE>(image).Pixels;
+    size_t sizePixels = bus.PixelsSize();
+    uint8_t* pOriginal = new uint8_t[sizePixels];
+    uint8_t* pExpected = new uint8_t[sizePixels];
+    bool passed = true;
+
+    for (uint32_t count = 0; count < pixelCount; count += 1 + count / 2)
+    {
+        size_t sizeFront = count * T_COLOR_FEATURE::PixelSize;
+        uint16_t first = static_cast<uint16_t>(count / 3);
+        size_t sizeFirst = first * T_COLOR_FEATURE::PixelSize;
+
+        FillRandom(pOriginal, sizePixels, count);
+
+        // whole, left
+        memcpy(pExpected, pOriginal + sizeFront, sizePixels - sizeFront);
+        memcpy(pExpected + sizePixels - sizeFront, pOriginal, sizeFront);
+
+        memcpy(bus.Pixels(), pOriginal, sizePixels);
+        bus.RotateLeft(count);
+        passed = passed && (memcmp(bus.Pixels(), pExpected, sizePixels) == 0);
+
+        memcpy(pImagePixels, pOriginal, sizePixels);
+        image.RotateLeft(count);
+        passed = passed && (memcmp(pImagePixels, pExpected, sizePixels) == 0);
+
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            dib.Pixels()[indexPixel] = T_COLOR_FEATURE::retrievePixelColor(pOriginal, indexPixel);
+        }
+        dib.RotateLeft(count);
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            passed = passed && (dib.GetPixelColor(indexPixel) == T_COLOR_FEATURE::retrievePixelColor(pExpected, indexPixel));
+        }
+
+        // and back right
+        bus.RotateRight(count);
+        passed = passed && (memcmp(bus.Pixels(), pOriginal, sizePixels) == 0);
+        image.RotateRight(count);
+        passed = passed && (memcmp(pImagePixels, pOriginal, sizePixels) == 0);
+        dib.RotateRight(count);
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            passed = passed && (dib.GetPixelColor(indexPixel) == T_COLOR_FEATURE::retrievePixelColor(pOriginal, indexPixel));
+        }
+
+        // a range that leaves the first pixels as they are
+        if (first + count < pixelCount)
+        {
+            size_t sizeRange = sizePixels - sizeFirst;
+
+            memcpy(pExpected, pOriginal, sizeFirst);
+            memcpy(pExpected + sizeFirst, pOriginal + sizeFirst + sizeFront, sizeRange - sizeFront);
+            memcpy(pExpected + sizePixels - sizeFront, pOriginal + sizeFirst, sizeFront);
+
+            bus.RotateLeft(count, first, pixelCount - 1);
+            passed = passed && (memcmp(bus.Pixels(), pExpected, sizePixels) == 0);
+            bus.RotateRight(count, first, pixelCount - 1);
+            passed = passed && (memcmp(bus.Pixels(), pOriginal, sizePixels) == 0);
+        }
+    }
+    Check("RotateInPlace", passed);
+
+    delete[] pOriginal;
+    delete[] pExpected;
+}
+
+// checks the span writes against per pixel SetPixelColor
+template <typename T_COLOR_FEATURE> void TestSetPixels(uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> expected(pixelCount, 0);
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> bus(pixelCount, 0);
+    expected.Begin();
+    bus.Begin();
+
+    uint8_t* frame = new uint8_t[pixelCount * NeoRgbFeature::PixelSize];
+    ColorObject* colors = new ColorObject[pixelCount];
+    FillRandom(frame, pixelCount * NeoRgbFeature::PixelSize, pixelCount);
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        colors[indexPixel] = NeoRgbFeature::retrievePixelColor(frame, indexPixel);
+    }
+
+    // a span that runs past the end only writes up to it
+    uint16_t first = pixelCount / 3;
+    for (uint16_t indexPixel = first; indexPixel < pixelCount; indexPixel++)
+    {
+        expected.SetPixelColor(indexPixel, colors[indexPixel - first]);
+    }
+    bus.SetPixels(first, colors, pixelCount);
+    bool passed = (memcmp(bus.Pixels(), expected.Pixels(), bus.PixelsSize()) == 0);
+    bus.SetPixels(pixelCount, colors, pixelCount);
+    passed = passed && (memcmp(bus.Pixels(), expected.Pixels(), bus.PixelsSize()) == 0);
+    Check("NeoPixelBus::SetPixels", passed);
+
+    for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+    {
+        expected.SetPixelColor(indexPixel, colors[indexPixel]);
+    }
+    bus.ClearTo(0);
+    bus.template SetPixelsRaw<NeoRgbFeature>(0, frame, pixelCount);
+    passed = (memcmp(bus.Pixels(), expected.Pixels(), bus.PixelsSize()) == 0);
+    bus.ClearTo(0);
+    bus.template SetPixelsRaw<T_COLOR_FEATURE>(0, expected.Pixels(), pixelCount);
+    passed = passed && (memcmp(bus.Pixels(), expected.Pixels(), bus.PixelsSize()) == 0);
+
+    // a source of the same feature at an odd address
+    uint8_t* unaligned = new uint8_t[bus.PixelsSize() + 1];
+    memcpy(unaligned + 1, expected.Pixels(), bus.PixelsSize());
+    bus.ClearTo(0);
+    bus.template SetPixelsRaw<T_COLOR_FEATURE>(0, unaligned + 1, pixelCount);
+    passed = passed && (memcmp(bus.Pixels(), expected.Pixels(), bus.PixelsSize()) == 0);
+    delete[] unaligned;
+    Check("NeoPixelBus::SetPixelsRaw", passed);
+
+    delete[] colors;
+    delete[] frame;
+}
+
+// checks the replicate and overlapping moves of the feature against the
+// byte at a time reference
+template <typename T_COLOR_FEATURE> void TestElements(uint16_t pixelCount)
+{
+    typedef ElementsBytewise<T_COLOR_FEATURE::PixelSize> Reference;
+
+    size_t sizePixels = pixelCount * T_COLOR_FEATURE::PixelSize;
+    uint8_t* pPixels = new uint8_t[sizePixels];
+    uint8_t* pExpected = new uint8_t[sizePixels];
+    bool passed = true;
+
+    for (uint32_t count = 0; count < pixelCount; count += 1 + count / 2)
+    {
+        uint16_t moveCount = pixelCount - 1 - count / 2;
+        uint8_t* pFar = pPixels + (count / 2 + 1) * T_COLOR_FEATURE::PixelSize;
+        uint8_t* pFarExpected = pExpected + (count / 2 + 1) * T_COLOR_FEATURE::PixelSize;
+
+        FillRandom(pPixels, sizePixels, count);
+        memcpy(pExpected, pPixels, sizePixels);
+        T_COLOR_FEATURE::replicatePixel(pPixels + T_COLOR_FEATURE::PixelSize, pPixels, count);
+        Reference::replicatePixel(pExpected + T_COLOR_FEATURE::PixelSize, pExpected, count);
+        passed = passed && (memcmp(pPixels, pExpected, sizePixels) == 0);
+
+        FillRandom(pPixels, sizePixels, count + 1);
+        memcpy(pExpected, pPixels, sizePixels);
+        T_COLOR_FEATURE::movePixelsInc(pPixels, pFar, moveCount);
+        Reference::movePixelsInc(pExpected, pFarExpected, moveCount);
+        passed = passed && (memcmp(pPixels, pExpected, sizePixels) == 0);
+
+        FillRandom(pPixels, sizePixels, count + 2);
+        memcpy(pExpected, pPixels, sizePixels);
+        T_COLOR_FEATURE::movePixelsDec(pFar, pPixels, moveCount);
+        Reference::movePixelsDec(pFarExpected, pExpected, moveCount);
+        passed = passed && (memcmp(pPixels, pExpected, sizePixels) == 0);
+    }
+    Check("NeoElementsCopy", passed);
+
+    delete[] pPixels;
+    delete[] pExpected;
+}
+
+// a color with its channels set from the bytes given
+template <typename T_COLOR_OBJECT> T_COLOR_OBJECT ColorFromBytes(const uint8_t* pBytes)
+{
+    T_COLOR_OBJECT color;
+    memcpy(&color, pBytes, sizeof(T_COLOR_OBJECT));
+    return color;
+}
+
+template <typename T_COLOR_OBJECT> bool ColorWithin(const T_COLOR_OBJECT& left, const T_COLOR_OBJECT& right, int within)
+{
+    const uint8_t* pLeft = reinterpret_cast<const uint8_t*>(&left);
+    const uint8_t* pRight = reinterpret_cast<const uint8_t*>(&right);
+
+    for (size_t index = 0; index < sizeof(T_COLOR_OBJECT); index++)
+    {
+        int diff = pLeft[index] - pRight[index];
+        if (diff < -within || diff > within)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T_COLOR_OBJECT> bool ColorWithinOne(const T_COLOR_OBJECT& left, const T_COLOR_OBJECT& right)
+{
+    return ColorWithin(left, right, 1);
+}
+
+// checks the integer hue colors against the float ones for every input
+void TestHue()
+{
+    bool passedHsb = true;
+    bool passedHsl = true;
+
+    for (uint16_t h = 0; h < 256; h++)
+    {
+        for (uint16_t s = 0; s < 256; s++)
+        {
+            for (uint16_t v = 0; v < 256; v++)
+            {
+                passedHsb = passedHsb && ColorWithin(RgbColor(HsbColor8(h, s, v)),
+                    RgbColor(HsbColor(h / 256.0f, s / 255.0f, v / 255.0f)),
+                    2);
+                passedHsl = passedHsl && ColorWithin(RgbColor(HslColor8(h, s, v)),
+                    RgbColor(HslColor(h / 256.0f, s / 255.0f, v / 255.0f)),
+                    2);
+            }
+        }
+    }
+    Check("HsbColor8", passedHsb);
+    Check("HslColor8", passedHsl);
+}
+
+// checks a policy's uint16_t hue blend against its float one; hues half
+// a turn apart are skipped as the float policies pick by the sign there
+template <typename T_NEOHUEBLEND> void TestHueBlend(const char* name)
+{
+    uint16_t hues[1024];
+    FillRandom(reinterpret_cast<uint8_t*>(hues), sizeof(hues), 23);
+    hues[0] = 0;
+    hues[1] = 0;
+    hues[2] = 65535;
+    hues[3] = 0;
+
+    bool passed = true;
+    for (size_t index = 0; index < 1024; index += 2)
+    {
+        uint16_t left = hues[index];
+        uint16_t right = hues[index + 1];
+
+        if (static_cast<uint16_t>(right - left) == 0x8000)
+        {
+            continue;
+        }
+
+        for (uint32_t progress = 0; progress < 65536; progress += 257)
+        {
+            uint16_t blend = T_NEOHUEBLEND::HueBlend16(left, right, static_cast<uint16_t>(progress));
+            float blendFloat = T_NEOHUEBLEND::HueBlend(left / 65536.0f, right / 65536.0f, progress / 65535.0f);
+
+            // compared around the wheel, so 1.0 and 0.0 are the same
+            int16_t diff = static_cast<int16_t>(blend - static_cast<uint16_t>(static_cast<int32_t>(blendFloat * 65536.0f)));
+            passed = passed && (diff >= -2 && diff <= 2);
+        }
+    }
+
+    // double and int arguments only have the float blend to go to
+    passed = passed && (T_NEOHUEBLEND::HueBlend(0.1, 0.3, 0.5) == T_NEOHUEBLEND::HueBlend(0.1f, 0.3f, 0.5f));
+    passed = passed && (T_NEOHUEBLEND::HueBlend(0, 0, 1) == T_NEOHUEBLEND::HueBlend(0.0f, 0.0f, 1.0f));
+    Check(name, passed);
+}
+
+// checks the integer blends against the float blends, every input of the
+// 8 bit LinearBlend and a spread of all the others
+template <typename T_COLOR_OBJECT> void TestBlend(const char* name)
+{
+    bool passed = true;
+
+    for (uint16_t left = 0; left < 256; left++)
+    {
+        for (uint16_t right = 0; right < 256; right++)
+        {
+            const uint8_t bytesLeft[4] = { static_cast<uint8_t>(left),
+                static_cast<uint8_t>(right),
+                static_cast<uint8_t>(left ^ right),
+                static_cast<uint8_t>(255 - left) };
+            const uint8_t bytesRight[4] = { static_cast<uint8_t>(right),
+                static_cast<uint8_t>(left),
+                static_cast<uint8_t>(255 - right),
+                static_cast<uint8_t>(left + right) };
+            T_COLOR_OBJECT colorLeft = ColorFromBytes<T_COLOR_OBJECT>(bytesLeft);
+            T_COLOR_OBJECT colorRight = ColorFromBytes<T_COLOR_OBJECT>(bytesRight);
+
+            for (uint16_t progress = 0; progress < 256; progress++)
+            {
+                passed = passed && ColorWithinOne(
+                    T_COLOR_OBJECT::LinearBlend8(colorLeft, colorRight, static_cast<uint8_t>(progress)),
+                    T_COLOR_OBJECT::LinearBlend(colorLeft, colorRight, progress / 255.0f));
+            }
+
+            for (uint32_t progress = 0; progress < 65536; progress += (progress < 65535 - 251) ? 251 : 65535 - progress)
+            {
+                passed = passed && ColorWithinOne(
+                    T_COLOR_OBJECT::LinearBlend16(colorLeft, colorRight, static_cast<uint16_t>(progress)),
+                    T_COLOR_OBJECT::LinearBlend(colorLeft, colorRight, progress / 65535.0f));
+                if (progress == 65535)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    // the first set of corners has the steepest gradients
+    uint8_t corners[32][4 * sizeof(T_COLOR_OBJECT)];
+    FillRandom(corners[0], sizeof(corners), 17);
+    for (size_t index = 0; index < sizeof(T_COLOR_OBJECT); index++)
+    {
+        corners[0][index] = 0;
+        corners[0][sizeof(T_COLOR_OBJECT) + index] = 255;
+        corners[0][2 * sizeof(T_COLOR_OBJECT) + index] = 255;
+        corners[0][3 * sizeof(T_COLOR_OBJECT) + index] = 0;
+    }
+
+    for (const uint8_t* corner : corners)
+    {
+        T_COLOR_OBJECT c00 = ColorFromBytes<T_COLOR_OBJECT>(corner);
+        T_COLOR_OBJECT c01 = ColorFromBytes<T_COLOR_OBJECT>(corner + sizeof(T_COLOR_OBJECT));
+        T_COLOR_OBJECT c10 = ColorFromBytes<T_COLOR_OBJECT>(corner + 2 * sizeof(T_COLOR_OBJECT));
+        T_COLOR_OBJECT c11 = ColorFromBytes<T_COLOR_OBJECT>(corner + 3 * sizeof(T_COLOR_OBJECT));
+
+        for (uint16_t x = 0; x < 256; x++)
+        {
+            for (uint16_t y = 0; y < 256; y++)
+            {
+                passed = passed && ColorWithinOne(
+                    T_COLOR_OBJECT::BilinearBlend8(c00, c01, c10, c11, static_cast<uint8_t>(x), static_cast<uint8_t>(y)),
+                    T_COLOR_OBJECT::BilinearBlend(c00, c01, c10, c11, x / 255.0f, y / 255.0f));
+            }
+        }
+
+        for (uint32_t x = 0; x < 65536; x += 1021)
+        {
+            for (uint32_t y = 0; y < 65536; y += 1021)
+            {
+                passed = passed && ColorWithinOne(
+                    T_COLOR_OBJECT::BilinearBlend16(c00, c01, c10, c11, static_cast<uint16_t>(x), static_cast<uint16_t>(y)),
+                    T_COLOR_OBJECT::BilinearBlend(c00, c01, c10, c11, x / 65535.0f, y / 65535.0f));
+            }
+        }
+        passed = passed && ColorWithinOne(
+            T_COLOR_OBJECT::BilinearBlend16(c00, c01, c10, c11, static_cast<uint16_t>(65535), static_cast<uint16_t>(65535)),
+            c11);
+    }
+
+    // a double progress only has the float blends to go to
+    T_COLOR_OBJECT black = ColorFromBytes<T_COLOR_OBJECT>(corners[0]);
+    T_COLOR_OBJECT white = ColorFromBytes<T_COLOR_OBJECT>(corners[0] + sizeof(T_COLOR_OBJECT));
+    passed = passed && (T_COLOR_OBJECT::LinearBlend(black, white, 0.5) == T_COLOR_OBJECT::LinearBlend(black, white, 0.5f));
+    passed = passed && (T_COLOR_OBJECT::BilinearBlend(black, white, white, black, 1.0, 0.0) == white);
+
+    Check(name, passed);
+}
+
+// checks an ESP32 I2S encoder against the nibble encoder
+template <typename T_ENCODER> void TestI2sEncoder(const char* name, uint16_t pixelCount, size_t pixelSize)
+{
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* pData = new uint8_t[sizeData];
+    uint32_t* pDma = new uint32_t[sizeData];
+    uint32_t* pDmaReference = new uint32_t[sizeData];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    NeoEsp32I2sNibbleEncoder::Encode(reinterpret_cast<uint8_t*>(pDmaReference), pData, sizeData);
+    T_ENCODER::Encode(reinterpret_cast<uint8_t*>(pDma), pData, sizeData);
+    Check(name, memcmp(pDma, pDmaReference, sizeData * c_dmaBytesPerPixelBytes) == 0);
+
+    delete[] pData;
+    delete[] pDma;
+    delete[] pDmaReference;
+}
+
+// checks the ESP8266 DMA encoders against the ESP32 nibble encoder, which
+// sends the same bit patterns, and that the UART bytes decode back
+void TestEsp8266Encoders(uint16_t pixelCount, size_t pixelSize)
+{
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* pData = new uint8_t[sizeData];
+    uint32_t* pDma = new uint32_t[sizeData];
+    uint32_t* pDmaReference = new uint32_t[sizeData];
+    uint8_t* pUart = new uint8_t[sizeData * 4];
+
+    FillRandom(pData, sizeData, pixelCount);
+    NeoEsp32I2sNibbleEncoder::Encode(reinterpret_cast<uint8_t*>(pDmaReference), pData, sizeData);
+
+    NeoEsp8266DmaEncoder<NeoEsp8266DmaSpeedBase>::Encode(reinterpret_cast<uint8_t*>(pDma), pData, sizeData);
+    bool passed = (memcmp(pDma, pDmaReference, sizeData * 4) == 0);
+    NeoEsp8266DmaEncoder<NeoEsp8266DmaInvertedSpeedBase>::Encode(reinterpret_cast<uint8_t*>(pDma), pData, sizeData);
+    for (size_t index = 0; index < sizeData; index++)
+    {
+        passed = passed && (pDma[index] == ~pDmaReference[index]);
+    }
+    Check("NeoEsp8266DmaEncoder::Encode", passed);
+
+    const uint8_t symbols[4] = NEO_ESP8266_UART_SYMBOLS;
+    NeoEsp8266UartEncoder::Encode(pUart, pData, sizeData);
+    passed = true;
+    for (size_t index = 0; index < sizeData; index++)
+    {
+        uint8_t value = 0;
+        for (size_t indexSymbol = 0; indexSymbol < 4; indexSymbol++)
+        {
+            const uint8_t* pSymbol = static_cast<const uint8_t*>(memchr(symbols, pUart[index * 4 + indexSymbol], 4));
+            passed = passed && (pSymbol != nullptr);
+            value = static_cast<uint8_t>((value << 2) | ((pSymbol != nullptr) ? (pSymbol - symbols) : 0));
+        }
+        passed = passed && (value == pData[index]);
+    }
+    Check("NeoEsp8266UartEncoder::Encode", passed);
+
+    delete[] pData;
+    delete[] pDma;
+    delete[] pDmaReference;
+    delete[] pUart;
+}
+
+// encodes one data stream per lane and checks every lane can be read back
+// from the DMA stream, also when scaled as encoded
+template <typename T_LANEWORD, typename T_TRANSPOSE> void TestI2sParallelEncoder(const char* name,
+    uint16_t pixelCount,
+    size_t pixelSize)
+{
+    typedef NeoEsp32I2sParallelEncoder<T_LANEWORD, T_TRANSPOSE> T_ENCODER;
+
+    size_t sizeData = pixelCount * pixelSize;
+    size_t sizeDma = sizeData * T_ENCODER::DmaBytesPerDataByte;
+    uint8_t* laneData[T_ENCODER::LaneCount];
+    size_t laneSizes[T_ENCODER::LaneCount];
+    uint32_t* pDma = new uint32_t[sizeDma / sizeof(uint32_t)];
+
+    for (uint8_t lane = 0; lane < T_ENCODER::LaneCount; lane++)
+    {
+        laneData[lane] = new uint8_t[sizeData];
+        laneSizes[lane] = sizeData;
+        FillRandom(laneData[lane], sizeData, pixelCount + lane);
+    }
+
+    T_ENCODER::Encode(reinterpret_cast<uint8_t*>(pDma), laneData, laneSizes, sizeData);
+
+    // the two 16 bit halves of every 32 bit word are sent swapped, so sent
+    // lane word slot is stored at slot ^ swap; every bit is high, bit, bit, low
+    const T_LANEWORD* pWords = reinterpret_cast<const T_LANEWORD*>(pDma);
+    const size_t swap = 2 / sizeof(T_LANEWORD);
+    const T_LANEWORD high = static_cast<T_LANEWORD>(~0);
+    bool passed = true;
+
+    for (size_t index = 0; index < sizeData && passed; index++)
+    {
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            const T_LANEWORD* pSlots = pWords + (index * 8 + bit) * 4;
+            T_LANEWORD expected = 0;
+            for (uint8_t lane = 0; lane < T_ENCODER::LaneCount; lane++)
+            {
+                expected |= static_cast<T_LANEWORD>(((laneData[lane][index] >> (7 - bit)) & 0x01) << lane);
+            }
+
+            passed = passed &&
+                pSlots[0 ^ swap] == high &&
+                pSlots[1 ^ swap] == expected &&
+                pSlots[2 ^ swap] == expected &&
+                pSlots[3 ^ swap] == 0;
+        }
+    }
+    Check(name, passed);
+
+    // the scaled encode matches encoding lanes scaled up front, the
+    // settings in front of every lane are left as they are
+    const size_t sizeSettings = 2;
+    uint8_t* laneScaled[T_ENCODER::LaneCount];
+    uint16_t laneScales[T_ENCODER::LaneCount];
+    size_t laneSettingsSizes[T_ENCODER::LaneCount];
+    uint8_t* pDmaScaled = new uint8_t[sizeDma];
+
+    for (uint8_t lane = 0; lane < T_ENCODER::LaneCount; lane++)
+    {
+        laneScales[lane] = static_cast<uint16_t>(lane * 17 + 1);
+        laneSettingsSizes[lane] = sizeSettings;
+        laneScaled[lane] = new uint8_t[sizeData];
+        memcpy(laneScaled[lane], laneData[lane], sizeSettings);
+        NeoScaleBytes(laneScaled[lane] + sizeSettings, laneData[lane] + sizeSettings, sizeData - sizeSettings, laneScales[lane]);
+    }
+
+    T_ENCODER::Encode(pDmaScaled, laneScaled, laneSizes, sizeData);
+    T_ENCODER::Encode(reinterpret_cast<uint8_t*>(pDma), laneData, laneSizes, laneScales, laneSettingsSizes, sizeData);
+    Check(name, memcmp(pDma, pDmaScaled, sizeDma) == 0);
+
+    for (uint8_t lane = 0; lane < T_ENCODER::LaneCount; lane++)
+    {
+        delete[] laneScaled[lane];
+        delete[] laneData[lane];
+    }
+    delete[] pDmaScaled;
+    delete[] pDma;
+}
+
+// checks the nibble translator against the bit translator
+void TestRmtTranslators(uint16_t pixelCount, size_t pixelSize)
+{
+    size_t sizeData = pixelCount * pixelSize;
+    uint8_t* pData = new uint8_t[sizeData];
+    uint32_t* pItems = new uint32_t[sizeData * 8];
+    uint32_t* pItemsReference = new uint32_t[sizeData * 8];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    size_t countReference = RmtTranslateAll(pData, sizeData, pItemsReference,
+        [](const uint8_t* src, uint32_t* dest, size_t src_size, size_t wanted_num, size_t* translated_size, size_t* item_num)
+        {
+            NeoEsp32RmtBitTranslator::Translate(src, dest, src_size, wanted_num, translated_size, item_num,
+                RmtBit0, RmtBit1, RmtDurationReset);
+        });
+    size_t count = RmtTranslateAll(pData, sizeData, pItems,
+        [](const uint8_t* src, uint32_t* dest, size_t src_size, size_t wanted_num, size_t* translated_size, size_t* item_num)
+        {
+            NeoEsp32RmtNibbleTranslator::Translate(src, dest, src_size, wanted_num, translated_size, item_num,
+                RmtNibbleItems, RmtDurationReset);
+        });
+    Check("NeoEsp32RmtNibbleTranslator::Translate",
+        count == countReference && memcmp(pItems, pItemsReference, count * sizeof(uint32_t)) == 0);
+
+    // odd request sizes and a single byte stream must stop at the same place
+    for (size_t wanted = 0; wanted < 20; wanted++)
+    {
+        size_t sizeBits, itemsBits, sizeNibbles, itemsNibbles;
+        size_t sizeSrc = wanted % 3;
+
+        NeoEsp32RmtBitTranslator::Translate(pData, pItemsReference, sizeSrc, wanted, &sizeBits, &itemsBits,
+            RmtBit0, RmtBit1, RmtDurationReset);
+        NeoEsp32RmtNibbleTranslator::Translate(pData, pItems, sizeSrc, wanted, &sizeNibbles, &itemsNibbles,
+            RmtNibbleItems, RmtDurationReset);
+        Check("NeoEsp32RmtNibbleTranslator::Translate",
+            sizeBits == sizeNibbles &&
+            itemsBits == itemsNibbles &&
+            memcmp(pItems, pItemsReference, itemsBits * sizeof(uint32_t)) == 0);
+    }
+
+    delete[] pData;
+    delete[] pItems;
+    delete[] pItemsReference;
+}
+
+// checks the transpose kernel against the reference over random lane bytes
+template <typename T_TRANSPOSE, typename T_LANEWORD> void TestTranspose(const char* name, uint16_t pixelCount)
+{
+    const uint8_t laneCount = NeoBitTransposeReference<T_LANEWORD>::LaneCount;
+
+    size_t sizeData = pixelCount * laneCount;
+    uint8_t* pData = new uint8_t[sizeData];
+    T_LANEWORD* pBits = new T_LANEWORD[pixelCount * 8];
+
+    FillRandom(pData, sizeData, pixelCount);
+
+    bool passed = true;
+    for (uint16_t index = 0; index < pixelCount; index++)
+    {
+        T_LANEWORD bitsReference[8];
+
+        NeoBitTransposeReference<T_LANEWORD>::Transpose(bitsReference, pData + index * laneCount);
+        T_TRANSPOSE::Transpose(pBits + index * 8, pData + index * laneCount);
+        passed = passed && (memcmp(bitsReference, pBits + index * 8, sizeof(bitsReference)) == 0);
+    }
+    Check(name, passed);
+
+    delete[] pData;
+    delete[] pBits;
+}
+
+void TestEncoders(uint16_t pixelCount, size_t pixelSize)
+{
+    TestI2sEncoder<NeoEsp32I2sByteEncoder>("NeoEsp32I2sByteEncoder::Encode", pixelCount, pixelSize);
+    TestRmtTranslators(pixelCount, pixelSize);
+    TestEsp8266Encoders(pixelCount, pixelSize);
+    TestI2sParallelEncoder<uint8_t, NeoBitTransposeSwar<uint8_t>>("NeoEsp32I2sParallelEncoder<X8>::Encode", pixelCount, pixelSize);
+    TestI2sParallelEncoder<uint16_t, NeoBitTransposeSwar<uint16_t>>("NeoEsp32I2sParallelEncoder<X16>::Encode", pixelCount, pixelSize);
+}
+
+void TestTransposes(uint16_t pixelCount)
+{
+    TestTranspose<NeoBitTransposeSwar<uint8_t>, uint8_t>("NeoBitTransposeSwar::Transpose", pixelCount);
+    TestTranspose<NeoBitTransposeLut<uint8_t>, uint8_t>("NeoBitTransposeLut::Transpose", pixelCount);
+    TestTranspose<NeoBitTransposeSwar<uint16_t>, uint16_t>("NeoBitTransposeSwar::Transpose", pixelCount);
+    TestTranspose<NeoBitTransposeLut<uint16_t>, uint16_t>("NeoBitTransposeLut::Transpose", pixelCount);
+}
+
+// checks that after edits that each dirty a part of the bus, the method
+// that only re-encodes the dirty bytes holds a full encode of the data
+template <typename T_COLOR_FEATURE> void TestDirtyRange(uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    CaptureBus<NeoPixelBus<T_COLOR_FEATURE, CaptureMethod<CaptureI2sEncoder>>> bus(pixelCount, 0);
+    bus.Begin();
+    bus.ClearTo(ColorObject(32));
+    bus.Show();
+
+    uint16_t indexPixel = 0;
+    for (uint16_t frame = 0; frame < 16; frame++)
+    {
+        indexPixel = (indexPixel + 7) % pixelCount;
+        bus.SetPixelColor(indexPixel, ColorObject(static_cast<uint8_t>(indexPixel)));
+        bus.Show();
+    }
+    bus.RotateLeft(1, pixelCount / 2, pixelCount - 1);
+    bus.Show();
+    Check("ShowDirtyPixel", bus.Method().IsConsistent());
+
+    // ranges that are empty or past the end are ignored, the end clamped
+    bus.Dirty(5, 2);
+    bus.Dirty(pixelCount, 0xffff);
+    bool passed = !bus.IsDirty();
+    bus.SetPixelColor(pixelCount - 1, ColorObject(7));
+    bus.ResetDirty();
+    bus.Dirty(pixelCount - 1, 0xffff);
+    bus.Show();
+    passed = passed && bus.Method().IsConsistent();
+    Check("NeoPixelBus::Dirty", passed);
+}
+
+static void CountComplete(void* context)
+{
+    (*static_cast<uint32_t*>(context))++;
+}
+
+// checks that the ShowAsync callback is called exactly once, after the
+// send, for methods that signal it and for methods that are polled
+void TestShowAsync()
+{
+    bool passed = true;
+    uint32_t completed = 0;
+
+    NeoPixelBus<NeoGrbFeature, NeoHostMethod> busHost(8, 0);
+    busHost.Begin();
+    busHost.Dirty();
+    passed = passed && busHost.ShowAsync(CountComplete, &completed) && completed == 1;
+    passed = passed && busHost.ShowAsync(CountComplete, &completed) && completed == 2;
+
+    CaptureBus<NeoPixelBus<NeoGrbFeature, CaptureSignalMethod>> busSignal(8, 0);
+    busSignal.Begin();
+    busSignal.Method().HoldSends(true);
+    busSignal.Dirty();
+    completed = 0;
+    passed = passed && busSignal.ShowAsync(CountComplete, &completed) && completed == 0;
+    busSignal.Dirty();
+    passed = passed && !busSignal.ShowAsync(CountComplete, &completed);
+    busSignal.Method().Complete();
+    passed = passed && completed == 1 && busSignal.CanShow() && completed == 1;
+
+    CaptureBus<NeoPixelBus<NeoGrbFeature, CaptureMethod<>>> busPolled(8, 0);
+    busPolled.Begin();
+    busPolled.Method().HoldSends(true);
+    busPolled.Dirty();
+    completed = 0;
+    passed = passed && busPolled.ShowAsync(CountComplete, &completed) && completed == 0;
+    passed = passed && !busPolled.Poll() && completed == 0;
+    busPolled.Method().Complete();
+    // only Poll calls the callback, CanShow just reports
+    passed = passed && busPolled.CanShow() && completed == 0;
+    passed = passed && busPolled.Poll() && completed == 1 && busPolled.Poll() && completed == 1;
+
+    Check("NeoPixelBus::ShowAsync", passed);
+}
+
+// checks the counters of NeoFrameStats and that NeoNoStats stays zero
+void TestStats()
+{
+    NeoPixelBus<NeoGrbFeature, NeoHostMethod, NeoFrameStats> bus(8, 0);
+    bus.Begin();
+    bus.Show();
+    bus.Show();
+    bus.SetPixelColor(3, RgbColor(1, 2, 3));
+    bus.Show();
+
+    NeoBusStats stats = bus.Stats();
+    Check("NeoFrameStats", stats.showCount == 2 &&
+        stats.skippedShowCount == 1 &&
+        stats.underrunCount == 0);
+
+    // the wait before an update must not wait on an update held back
+    // by the method, updating again sends it
+    CaptureBus<NeoPixelBus<NeoGrbFeature, CaptureStageMethod, NeoFrameStats>> busStaged(8, 0);
+    busStaged.Begin();
+    busStaged.SetPixelColor(0, RgbColor(1, 2, 3));
+    busStaged.Show();
+    bool held = !busStaged.CanShow() && busStaged.Method().Sent()[0] == 0;
+    busStaged.SetPixelColor(0, RgbColor(4, 5, 6));
+    busStaged.Show();
+    Check("NeoFrameStats staged", held &&
+        busStaged.Method().Sent()[0] == 5 &&
+        busStaged.CanShow());
+
+    NeoPixelBus<NeoGrbFeature, NeoHostMethod> busNoStats(8, 0);
+    busNoStats.Begin();
+    busNoStats.Show();
+    Check("NeoNoStats", busNoStats.Stats().showCount == 0);
+}
+
+// runs one animation of the given length while stepping the held clock
+// by updatePeriod microseconds, which is not a whole number of time scale
+// units, and checks it completes once and at the first update past its
+// end rather than late by the parts of a unit each update used to drop
+void TestAnimatorClock(const char* name,
+    NeoAnimatorClock clock,
+    uint16_t timeScale,
+    uint32_t duration,
+    uint32_t updatePeriod,
+    uint32_t expected)
+{
+    NeoPixelAnimator animator(1, timeScale, clock);
+    uint32_t completed = 0;
+    uint32_t elapsed = 0;
+    uint32_t completedAt = 0;
+
+    holdClock(true);
+    animator.StartAnimation(0, duration, [&](const AnimationParam& param)
+    {
+        if (param.state == AnimationState_Completed)
+        {
+            completed++;
+            completedAt = elapsed;
+        }
+    });
+
+    while (animator.IsAnimating())
+    {
+        advanceMicros(updatePeriod);
+        elapsed += updatePeriod;
+        animator.UpdateAnimations();
+    }
+    holdClock(false);
+
+    Check(name, completed == 1 && completedAt == expected);
+}
+
+// restarts an animation from its own completion callback for a long run,
+// updating every 17 ms, and checks the loop keeps the period of its 80 ms
+// duration, the part of an update past each end counting toward the next
+void TestAnimatorLoop()
+{
+    NeoPixelAnimator animator(1, NEO_CENTISECONDS);
+    uint32_t started = 0;
+    uint32_t completed = 0;
+
+    holdClock(true);
+    animator.StartAnimation(0, 8, [&](const AnimationParam& param)
+    {
+        if (param.state == AnimationState_Started)
+        {
+            started++;
+        }
+        else if (param.state == AnimationState_Completed)
+        {
+            completed++;
+            animator.RestartAnimation(param.index);
+        }
+    });
+
+    // 1700 seconds, a whole number of both periods
+    for (uint32_t update = 0; update < 100000; update++)
+    {
+        advanceMicros(17000);
+        animator.UpdateAnimations();
+    }
+    holdClock(false);
+
+    Check("NeoPixelAnimator::UpdateAnimations looping", completed == 21250 && started == 21250);
+}
+
+// one slot per pixel, as effects that animate each pixel allocate
+const uint16_t AnimatorSlots = 3000;
+
+// steps the animator by whole milliseconds until nothing is animating
+static void AnimatorRun(NeoPixelAnimator& animator, uint16_t updateLimit)
+{
+    while (animator.IsAnimating() && updateLimit-- != 0)
+    {
+        advanceMicros(1000);
+        animator.UpdateAnimations();
+    }
+}
+
+// checks the scheduled and free lists against what a scan of every slot
+// did: each animation completes once, stopped slots are handed out again,
+// and updates keep the order animations started in
+void TestAnimatorLists()
+{
+    uint16_t calls[AnimatorSlots] = {};
+    uint16_t completed[AnimatorSlots] = {};
+    bool passed = true;
+
+    // a few animations among many slots run to completion
+    {
+        NeoPixelAnimator animator(AnimatorSlots);
+        uint8_t random[64];
+        FillRandom(random, sizeof(random), 25);
+
+        for (uint8_t index = 0; index < 40; index++)
+        {
+            uint16_t indexAnimation;
+            passed = passed && animator.NextAvailableAnimation(&indexAnimation, random[index] * 11);
+            animator.StartAnimation(indexAnimation, 1 + random[index] % 50, [&](const AnimationParam& param)
+            {
+                passed = passed && (completed[param.index] == 0);
+                calls[param.index]++;
+                if (param.state == AnimationState_Completed)
+                {
+                    completed[param.index]++;
+                }
+            });
+        }
+
+        AnimatorRun(animator, 1000);
+
+        uint16_t countCompleted = 0;
+        for (uint16_t index = 0; index < AnimatorSlots; index++)
+        {
+            passed = passed && (completed[index] <= 1) && (calls[index] == 0 || completed[index] == 1);
+            countCompleted += completed[index];
+        }
+        passed = passed && (countCompleted == 40) && !animator.IsAnimating();
+    }
+    Check("NeoPixelAnimator::UpdateAnimations sparse", passed);
+
+    // one restarted from its own callback keeps its place
+    {
+        NeoPixelAnimator animator(4);
+        uint8_t order[40];
+        uint8_t countOrder = 0;
+        auto fnRecord = [&](const AnimationParam& param)
+        {
+            if (countOrder < sizeof(order))
+            {
+                order[countOrder++] = static_cast<uint8_t>(param.index);
+            }
+            if (param.state == AnimationState_Completed)
+            {
+                animator.RestartAnimation(param.index);
+            }
+        };
+
+        animator.StartAnimation(0, 3, fnRecord);
+        animator.StartAnimation(1, 5, fnRecord);
+        AnimatorRun(animator, 20);
+
+        passed = (countOrder == sizeof(order));
+        for (uint8_t index = 0; index < countOrder; index++)
+        {
+            passed = passed && (order[index] == index % 2);
+        }
+        animator.StopAll();
+        passed = passed && !animator.IsAnimating();
+    }
+    Check("NeoPixelAnimator::RestartAnimation", passed);
+
+    // stopped from a callback, by itself or all at once
+    {
+        NeoPixelAnimator animator(16);
+        uint16_t countCalls = 0;
+
+        animator.StartAnimation(5, 100, [&](const AnimationParam& param)
+        {
+            countCalls++;
+            animator.StopAnimation(param.index);
+        });
+        AnimatorRun(animator, 2);
+
+        uint16_t indexAnimation = 0;
+        passed = (countCalls == 1) &&
+            !animator.IsAnimating() &&
+            animator.NextAvailableAnimation(&indexAnimation, 5) &&
+            indexAnimation == 5;
+
+        countCalls = 0;
+        for (uint16_t index = 0; index < 10; index++)
+        {
+            animator.StartAnimation(index, 100, [&](const AnimationParam&)
+            {
+                countCalls++;
+                animator.StopAll();
+            });
+        }
+        AnimatorRun(animator, 2);
+        passed = passed && (countCalls == 1) && !animator.IsAnimating();
+    }
+    Check("NeoPixelAnimator::StopAll", passed);
+
+    // every slot in use, then freed one at a time
+    {
+        NeoPixelAnimator animator(AnimatorSlots);
+        auto fnNone = [](const AnimationParam&) {};
+
+        for (uint16_t index = 0; index < AnimatorSlots; index++)
+        {
+            animator.StartAnimation(index, 1000, fnNone);
+        }
+
+        uint16_t indexAnimation = 0;
+        passed = !animator.NextAvailableAnimation(&indexAnimation);
+
+        // found before and after an update moves it to the free list
+        animator.StopAnimation(1234);
+        passed = passed && animator.NextAvailableAnimation(&indexAnimation) && indexAnimation == 1234;
+        advanceMicros(1000);
+        animator.UpdateAnimations();
+        passed = passed && animator.NextAvailableAnimation(&indexAnimation) && indexAnimation == 1234;
+
+        animator.StartAnimation(indexAnimation, 1000, fnNone);
+        passed = passed && !animator.NextAvailableAnimation(&indexAnimation);
+
+        animator.StopAll();
+        advanceMicros(1000);
+        animator.UpdateAnimations();
+        passed = passed && !animator.IsAnimating() && animator.NextAvailableAnimation(&indexAnimation, 77) && indexAnimation == 77;
+    }
+    Check("NeoPixelAnimator::NextAvailableAnimation", passed);
+}
+
+// checks the animator keeps time, and 32 bit durations
+void TestAnimator()
+{
+    TestAnimatorClock("NeoPixelAnimator::UpdateAnimations millis",
+        NeoAnimatorClock_Millis,
+        NEO_CENTISECONDS,
+        15,
+        15000,
+        150000);
+    TestAnimatorClock("NeoPixelAnimator::UpdateAnimations micros",
+        NeoAnimatorClock_Micros,
+        1000,
+        150,
+        1500,
+        150000);
+    TestAnimatorLoop();
+
+    NeoPixelAnimator animator(1);
+    animator.StartAnimation(0, 100000, [](const AnimationParam&) {});
+    bool passed = (animator.AnimationDuration(0) == 100000);
+    animator.ChangeAnimationDuration(0, 200000);
+    passed = passed && (animator.AnimationDuration(0) == 200000) && animator.IsAnimationActive(0);
+    animator.StopAll();
+    passed = passed && !animator.IsAnimating();
+    Check("NeoPixelAnimator::AnimationDuration", passed);
+
+    TestAnimatorLists();
+}
+
+// checks that NeoPixelBrightnessBus sends the pixels dimmed while keeping
+// the colors they were set to, on the wire path and the dim and restore path
+template <typename T_COLOR_FEATURE, typename T_METHOD> void TestBrightness(const char* name, uint16_t pixelCount)
+{
+    CaptureBus<NeoPixelBrightnessBus<T_COLOR_FEATURE, T_METHOD>> bus(pixelCount, 0);
+    bus.Begin();
+
+    uint8_t* pixelsRandom = new uint8_t[bus.PixelsSize()];
+    FillRandom(pixelsRandom, bus.PixelsSize(), pixelCount);
+    memcpy(bus.Pixels(), pixelsRandom, bus.PixelsSize());
+
+    bool passed = true;
+    for (uint16_t brightness = 0; brightness < 256; brightness += 51)
+    {
+        bus.SetBrightness(static_cast<uint8_t>(brightness));
+        bus.Show();
+
+        const uint8_t* sent = T_COLOR_FEATURE::pixels(bus.Method().Sent());
+        for (uint16_t index = 0; index < pixelCount; index++)
+        {
+            typename T_COLOR_FEATURE::ColorObject color = T_COLOR_FEATURE::retrievePixelColor(pixelsRandom, index);
+            passed = passed && (T_COLOR_FEATURE::retrievePixelColor(sent, index) == color.Dim(static_cast<uint8_t>(brightness)));
+        }
+        passed = passed && (memcmp(bus.Pixels(), pixelsRandom, bus.PixelsSize()) == 0);
+    }
+    Check(name, passed);
+    delete[] pixelsRandom;
+}
+
+// a method that reads the pixels after Show returns can't have them dimmed
+// and restored around it, so they are sent undimmed rather than restored
+void TestBrightnessDeferred()
+{
+    CaptureBus<NeoPixelBrightnessBus<NeoGrbFeature, CaptureStageMethod>> bus(8, 0);
+    bus.Begin();
+    bus.SetBrightness(127);
+    bus.SetPixelColor(0, RgbColor(200, 100, 50));
+    bus.Show();
+    bus.Show();
+
+    const uint8_t* sent = NeoGrbFeature::pixels(bus.Method().Sent());
+    Check("NeoPixelBrightnessBus::ShowDeferred",
+        NeoGrbFeature::retrievePixelColor(sent, 0) == RgbColor(200, 100, 50) &&
+        bus.GetPixelColor(0) == RgbColor(200, 100, 50));
+}
+
+// checks that the dithered bytes sent over 256 frames add up to the 16 bit
+// gamma value of every byte, and that the pixels keep their colors
+template <typename T_COLOR_FEATURE> void TestGamma(uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    CaptureBus<NeoPixelGammaBus<T_COLOR_FEATURE, CaptureMethod<>>> bus(pixelCount, 0);
+    bus.Begin();
+    bus.SetWhiteBalance(ColorObject(255, 224, 192));
+
+    uint8_t* pixelsRandom = new uint8_t[bus.PixelsSize()];
+    FillRandom(pixelsRandom, bus.PixelsSize(), pixelCount);
+    for (uint16_t index = 0; index < pixelCount; index++)
+    {
+        // keep the DotStar headers valid and the low end covered
+        T_COLOR_FEATURE::applyPixelColor(pixelsRandom, index,
+            (index % 4) ? T_COLOR_FEATURE::retrievePixelColor(pixelsRandom, index) : ColorObject(index % 16));
+    }
+    memcpy(bus.Pixels(), pixelsRandom, bus.PixelsSize());
+
+    uint32_t* sums = new uint32_t[bus.PixelsSize()]();
+    for (uint16_t frame = 0; frame < 256; frame++)
+    {
+        bus.Show();
+        const uint8_t* sent = T_COLOR_FEATURE::pixels(bus.Method().Sent());
+        for (size_t index = 0; index < bus.PixelsSize(); index++)
+        {
+            sums[index] += sent[index];
+        }
+    }
+
+    bool passed = (memcmp(bus.Pixels(), pixelsRandom, bus.PixelsSize()) == 0);
+    for (size_t index = 0; index < bus.PixelsSize(); index++)
+    {
+        passed = passed && (sums[index] == bus.GammaCorrect(index % T_COLOR_FEATURE::PixelSize, pixelsRandom[index]));
+    }
+    Check("NeoPixelGammaBus::Show", passed);
+
+    bus.SetDithering(false);
+    bus.Show();
+    const uint8_t* sent = T_COLOR_FEATURE::pixels(bus.Method().Sent());
+    passed = (memcmp(bus.Pixels(), pixelsRandom, bus.PixelsSize()) == 0);
+    for (size_t index = 0; index < bus.PixelsSize(); index++)
+    {
+        uint16_t expected = (bus.GammaCorrect(index % T_COLOR_FEATURE::PixelSize, pixelsRandom[index]) + 128) >> 8;
+        passed = passed && (sent[index] == expected);
+    }
+    Check("NeoPixelGammaBus::ShowRounded", passed);
+
+    delete[] sums;
+    delete[] pixelsRandom;
+}
+
+// runs the same edits on a NeoPixelRingBus and a plain bus and checks the
+// ring sends, and reads back, what the plain bus holds
+template <typename T_COLOR_FEATURE, typename T_METHOD> void TestRing(const char* name, uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod> plain(pixelCount, 0);
+    CaptureBus<NeoPixelRingBus<T_COLOR_FEATURE, T_METHOD>> ring(pixelCount, 0);
+    plain.Begin();
+    ring.Begin();
+
+    FillRandom(plain.Pixels(), plain.PixelsSize(), pixelCount);
+    memcpy(ring.Pixels(), plain.Pixels(), plain.PixelsSize());
+    ring.Dirty();
+
+    uint8_t* source = new uint8_t[plain.PixelsSize()];
+    FillRandom(source, plain.PixelsSize(), pixelCount + 1);
+
+    bool passed = true;
+    for (uint16_t step = 0; step < 96; step++)
+    {
+        uint16_t index = (step * 37) % pixelCount;
+        uint16_t last = pixelCount - 1 - (step * 11) % (pixelCount / 2);
+        uint16_t count = (step * 13) % pixelCount;
+        ColorObject color(static_cast<uint8_t>(step * 29));
+
+        switch (step % 8)
+        {
+        case 0:
+        case 1:
+            plain.SetPixelColor(index, color);
+            ring.SetPixelColor(index, color);
+            break;
+        case 2:
+        case 3:
+            plain.RotateLeft(count);
+            ring.RotateLeft(count);
+            break;
+        case 4:
+            plain.RotateRight(count);
+            ring.RotateRight(count);
+            break;
+        case 5:
+            plain.ClearTo(color, index / 2, last);
+            ring.ClearTo(color, index / 2, last);
+            break;
+        case 6:
+            plain.ShiftLeft(step % 5, index / 2, last);
+            ring.ShiftLeft(step % 5, index / 2, last);
+            break;
+        case 7:
+            plain.SwapPixelColor(index, last);
+            ring.SwapPixelColor(index, last);
+            break;
+        }
+
+        if (step % 4 == 1)
+        {
+            // a span from the end of the strip wraps around the ring's front
+            uint16_t first = pixelCount - 1 - index / 4;
+            plain.template SetPixelsRaw<T_COLOR_FEATURE>(first, source, count);
+            ring.template SetPixelsRaw<T_COLOR_FEATURE>(first, source, count);
+        }
+
+        if (step % 3 == 0)
+        {
+            ring.Show();
+            passed = passed && (memcmp(T_COLOR_FEATURE::pixels(ring.Method().Sent()), plain.Pixels(), plain.PixelsSize()) == 0);
+        }
+        for (uint16_t indexPixel = 0; indexPixel < pixelCount; indexPixel++)
+        {
+            passed = passed && (ring.GetPixelColor(indexPixel) == plain.GetPixelColor(indexPixel));
+        }
+    }
+
+    // a rotate of the whole ring changes every pixel sent
+    ring.Show();
+    ring.RotateLeft(1);
+    passed = passed && ring.IsDirty();
+    ring.Show();
+    ring.RotateRight(1);
+    passed = passed && ring.IsDirty();
+
+    passed = passed && (memcmp(ring.Pixels(), plain.Pixels(), plain.PixelsSize()) == 0);
+    Check(name, passed);
+    delete[] source;
+}
+
+// the current of the frame last sent by a capture method
+template <typename T_COLOR_FEATURE, typename T_BUS> uint32_t CalcSentMilliAmpere(const T_BUS& bus,
+    const typename T_COLOR_FEATURE::ColorObject::SettingsObject& settings)
+{
+    const uint8_t* pixels = T_COLOR_FEATURE::pixels(bus.Method().Sent());
+    uint32_t total = 0;
+
+    for (uint16_t index = 0; index < bus.PixelCount(); index++)
+    {
+        total += T_COLOR_FEATURE::retrievePixelColor(pixels, index).CalcTotalTenthMilliAmpere(settings);
+    }
+    return total / 10;
+}
+
+// checks the running total of NeoPixelPowerBus against a full walk after
+// every kind of change, and that a limited Show stays within the budget
+// without changing the pixels
+template <typename T_COLOR_FEATURE> void TestPower(uint16_t pixelCount,
+    const typename T_COLOR_FEATURE::ColorObject::SettingsObject& settings)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    CaptureBus<NeoPixelPowerBus<T_COLOR_FEATURE, CaptureMethod<>>> bus(pixelCount, 0, settings);
+    bus.Begin();
+
+    uint8_t* pixelsRandom = new uint8_t[bus.PixelsSize()];
+    FillRandom(pixelsRandom, bus.PixelsSize(), pixelCount);
+    memcpy(bus.Pixels(), pixelsRandom, bus.PixelsSize());
+
+    bool passed = (bus.CalcTotalMilliAmpere() == bus.CalcTotalMilliAmpere(settings));
+    for (uint16_t step = 0; step < 64; step++)
+    {
+        uint16_t first = (step * 37) % (pixelCount / 2);
+        uint16_t last = pixelCount - 1 - (step * 11) % (pixelCount / 2);
+        ColorObject color(static_cast<uint8_t>(step * 29));
+
+        switch (step % 6)
+        {
+        case 0:
+            bus.SetPixelColor(first, color);
+            break;
+        case 1:
+            bus.ClearTo(color, first, last);
+            break;
+        case 2:
+            bus.ShiftLeft(step % 5, first, last);
+            break;
+        case 3:
+            bus.ShiftRight(step % 7, first, last);
+            break;
+        case 4:
+            bus.RotateLeft(step % 3, first, last);
+            break;
+        case 5:
+            bus.SwapPixelColor(first, last);
+            break;
+        }
+        if (step % 4 == 2)
+        {
+            bus.template SetPixelsRaw<NeoRgbFeature>(first, pixelsRandom, last - first + 1);
+        }
+        passed = passed && (bus.CalcTotalMilliAmpere() == bus.CalcTotalMilliAmpere(settings));
+    }
+
+    // a zero shift of the whole strip changes nothing
+    bus.ShiftLeft(0);
+    bus.ShiftRight(0);
+    bus.ShiftRight(0, 0, pixelCount - 1);
+    passed = passed && (bus.CalcTotalMilliAmpere() == bus.CalcTotalMilliAmpere(settings));
+    Check("NeoPixelPowerBus::CalcTotalMilliAmpere", passed);
+
+    memcpy(bus.Pixels(), pixelsRandom, bus.PixelsSize());
+    uint32_t budget = bus.CalcTotalMilliAmpere() / 3;
+    bus.SetPowerBudget(budget);
+    bus.Show();
+    passed = (CalcSentMilliAmpere<T_COLOR_FEATURE>(bus, settings) <= budget);
+    passed = passed && (memcmp(bus.Pixels(), pixelsRandom, bus.PixelsSize()) == 0);
+    bus.SetPowerBudget(0);
+    passed = passed && bus.IsDirty();
+    bus.Show();
+    passed = passed && (memcmp(bus.Pixels(), pixelsRandom, bus.PixelsSize()) == 0);
+    Check("NeoPixelPowerBus::Show", passed);
+
+    // writes through the base bus bypass the total until Pixels() is asked for
+    typename NeoPixelPowerBus<T_COLOR_FEATURE, CaptureMethod<>>::Base& base = bus;
+    base.ClearTo(ColorObject(7));
+    bus.Pixels();
+    Check("NeoPixelPowerBus base writes", bus.CalcTotalMilliAmpere() == bus.CalcTotalMilliAmpere(settings));
+    delete[] pixelsRandom;
+}
+
+// checks that the output side only ever sees the newest published frame
+template <typename T_COLOR_FEATURE> void TestFrameQueue(uint16_t pixelCount)
+{
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelBusFrameQueue<T_COLOR_FEATURE, NeoHostMethod> queue(pixelCount, 0);
+    NeoPixelBus<T_COLOR_FEATURE, NeoHostMethod>& bus = queue.Bus();
+    queue.Begin();
+
+    bool passed = !queue.Process();
+
+    queue.ClearTo(ColorObject(1));
+    queue.Show();
+    queue.ClearTo(ColorObject(2));
+    queue.Show(false);
+    passed = passed && queue.Process() && !queue.Process();
+    passed = passed && (bus.GetPixelColor(pixelCount - 1) == ColorObject(2));
+
+    // without consistency the back frame is the one the output side dropped
+    passed = passed && (queue.GetPixelColor(0) == ColorObject(1));
+    queue.ClearTo(ColorObject(3));
+    queue.Show();
+    passed = passed && (queue.GetPixelColor(0) == ColorObject(3));
+    passed = passed && queue.Process() && (bus.GetPixelColor(0) == ColorObject(3));
+    Check("NeoPixelBusFrameQueue", passed);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        s_filter = argv[1];
+    }
+
+    if (Enabled("Bus"))
+    {
+        TestShowAsync();
+        TestStats();
+    }
+    if (Enabled("Animator"))
+    {
+        TestAnimator();
+    }
+    if (Enabled("Brightness"))
+    {
+        TestBrightnessDeferred();
+    }
+    if (Enabled("Color"))
+    {
+        TestBlend<RgbColor>("RgbColor::LinearBlend");
+        TestBlend<RgbwColor>("RgbwColor::LinearBlend");
+        TestHue();
+        TestHueBlend<NeoHueBlendShortestDistance>("NeoHueBlendShortestDistance");
+        TestHueBlend<NeoHueBlendLongestDistance>("NeoHueBlendLongestDistance");
+        TestHueBlend<NeoHueBlendClockwiseDirection>("NeoHueBlendClockwiseDirection");
+        TestHueBlend<NeoHueBlendCounterClockwiseDirection>("NeoHueBlendCounterClockwiseDirection");
+    }
+
+    for (uint16_t pixelCount : PixelCounts)
+    {
+        if (Enabled("Bus"))
+        {
+            TestBuffer<NeoGrbFeature>(pixelCount);
+            TestBuffer<NeoGrbwFeature>(pixelCount);
+            TestBuffer<DotStarBgrFeature>(pixelCount);
+
+            TestRotate<NeoGrbFeature>(pixelCount);
+            TestRotate<NeoGrbwFeature>(pixelCount);
+
+            TestSetPixels<NeoGrbFeature>(pixelCount);
+            TestSetPixels<NeoBrgFeature>(pixelCount);
+            TestSetPixels<NeoGrbwFeature>(pixelCount);
+            TestSetPixels<DotStarBgrFeature>(pixelCount);
+
+            TestDirtyRange<NeoGrbFeature>(pixelCount);
+            TestDirtyRange<NeoWrgbTm1814Feature>(pixelCount);
+
+            TestFrameQueue<NeoGrbFeature>(pixelCount);
+        }
+        if (Enabled("Elements"))
+        {
+            TestElements<NeoGrbFeature>(pixelCount);
+            TestElements<NeoGrbwFeature>(pixelCount);
+            TestElements<DotStarBgrFeature>(pixelCount);
+        }
+        if (Enabled("Ring") && pixelCount <= 1000)
+        {
+            TestRing<NeoGrbFeature, CaptureRotateMethod>("NeoPixelRingBus", pixelCount);
+            TestRing<NeoGrbFeature, CaptureMethod<>>("NeoPixelRingBus::Unrotated", pixelCount);
+            TestRing<NeoWrgbTm1814Feature, CaptureRotateMethod>("NeoPixelRingBus", pixelCount);
+            TestRing<NeoWrgbTm1814Feature, CaptureMethod<>>("NeoPixelRingBus::Unrotated", pixelCount);
+        }
+        if (Enabled("Power"))
+        {
+            TestPower<NeoGrbFeature>(pixelCount, NeoRgbCurrentSettings(160, 160, 160));
+            TestPower<NeoGrbwFeature>(pixelCount, NeoRgbwCurrentSettings(160, 160, 160, 200));
+        }
+        if (Enabled("Brightness"))
+        {
+            TestBrightness<NeoGrbFeature, CaptureScaleMethod>("NeoPixelBrightnessBus::Show", pixelCount);
+            TestBrightness<NeoGrbFeature, CaptureMethod<>>("NeoPixelBrightnessBus::ShowDimmed", pixelCount);
+            TestBrightness<DotStarBgrFeature, CaptureScaleMethod>("NeoPixelBrightnessBus::Show", pixelCount);
+        }
+        if (Enabled("Gamma"))
+        {
+            TestGamma<NeoGrbFeature>(pixelCount);
+            TestGamma<NeoGrbwFeature>(pixelCount);
+            TestGamma<DotStarBgrFeature>(pixelCount);
+        }
+        if (Enabled("Encoder"))
+        {
+            TestEncoders(pixelCount, Neo3Elements::PixelSize);
+            TestEncoders(pixelCount, Neo4Elements::PixelSize);
+            TestTransposes(pixelCount);
+        }
+    }
+
+    printf("%u checks, %u failed\n",
+        static_cast<unsigned>(s_checkCount),
+        static_cast<unsigned>(s_failedCount));
+    return (s_failedCount != 0) ? 1 : 0;
+}
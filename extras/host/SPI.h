@@ -0,0 +1,69 @@
+/*-------------------------------------------------------------------------
+Minimal Arduino SPI shim so the NeoPixelBus hardware SPI methods can be
+built on a desktop host; transfers are accepted and discarded.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+#pragma once
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings
+{
+public:
+    SPISettings(uint32_t, uint8_t, uint8_t)
+    {
+    }
+};
+
+class SPIClass
+{
+public:
+    void begin()
+    {
+    }
+
+    void end()
+    {
+    }
+
+    void beginTransaction(SPISettings)
+    {
+    }
+
+    void endTransaction()
+    {
+    }
+
+    uint8_t transfer(uint8_t data)
+    {
+        return data;
+    }
+};
+
+extern SPIClass SPI;
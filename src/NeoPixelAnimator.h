@@ -63,10 +63,21 @@ typedef std::function<void(const AnimationParam& param)> AnimUpdateCallback;
 #define NEO_SECONDS          1000    // ~18.2 hours max duration, second updates
 #define NEO_DECASECONDS     10000    // ~7.5 days, 10 second updates
 
+// the time source the time scale counts; durations are 32 bits, so with
+// micros() and a time scale of 1 the longest is ~71 minutes.  Either clock
+// wraps, so UpdateAnimations must be called at least once per wrap
+enum NeoAnimatorClock
+{
+    NeoAnimatorClock_Millis,
+    NeoAnimatorClock_Micros
+};
+
 class NeoPixelAnimator
 {
 public:
-    NeoPixelAnimator(uint16_t countAnimations, uint16_t timeScale = NEO_MILLISECONDS);
+    NeoPixelAnimator(uint16_t countAnimations,
+        uint16_t timeScale = NEO_MILLISECONDS,
+        NeoAnimatorClock clock = NeoAnimatorClock_Millis);
     ~NeoPixelAnimator();
 
     bool IsAnimating() const
@@ -77,7 +88,7 @@ public:
 
     bool NextAvailableAnimation(uint16_t* indexAvailable, uint16_t indexStart = 0);
 
-    void StartAnimation(uint16_t indexAnimation, uint16_t duration, AnimUpdateCallback animUpdate);
+    void StartAnimation(uint16_t indexAnimation, uint32_t duration, AnimUpdateCallback animUpdate);
     void StopAnimation(uint16_t indexAnimation);
     void StopAll();
 
@@ -100,7 +111,7 @@ public:
         return (IsAnimating() && _animations[indexAnimation]._remaining != 0);
     }
 
-    uint16_t AnimationDuration(uint16_t indexAnimation)
+    uint32_t AnimationDuration(uint16_t indexAnimation)
     {
         if (indexAnimation >= _countAnimations)
         {
@@ -109,7 +120,7 @@ public:
         return _animations[indexAnimation]._duration;
     }
 
-    void ChangeAnimationDuration(uint16_t indexAnimation, uint16_t newDuration);
+    void ChangeAnimationDuration(uint16_t indexAnimation, uint32_t newDuration);
 
     void UpdateAnimations();
 
@@ -126,7 +137,7 @@ public:
     void Resume()
     {
         _isRunning = true;
-        _animationLastTick = millis();
+        _animationLastTick = _currentTick();
     }
 
     uint16_t getTimeScale()
@@ -139,20 +150,38 @@ public:
         _timeScale = (timeScale < 1) ? (1) : (timeScale > 32768) ? 32768 : timeScale;
     }
 
+    NeoAnimatorClock getClock() const
+    {
+        return _clock;
+    }
+
 private:
+    // the index that ends a list
+    static const uint16_t NoAnimation = 0xffff;
+
+    // every context is on one of two lists linked through the array: the
+    // scheduled list, which updates walk in the order started, or the
+    // free list, which hands out slots.  A stopped animation stays
+    // scheduled until the next update passes it, so one restarted from
+    // its own callback keeps its place
     struct AnimationContext
     {
         AnimationContext() :
             _duration(0),
             _remaining(0),
-            _fnCallback(NULL)
+            _fnCallback(NULL),
+            _prev(NoAnimation),
+            _next(NoAnimation),
+            _isScheduled(false),
+            _isStarting(false)
         {}
 
-        void StartAnimation(uint16_t duration, AnimUpdateCallback animUpdate)
+        void StartAnimation(uint32_t duration, AnimUpdateCallback animUpdate)
         {
             _duration = duration;
             _remaining = duration;
             _fnCallback = animUpdate;
+            _isStarting = true;
         }
 
         void StopAnimation()
@@ -165,16 +194,41 @@ private:
             return (float)(_duration - _remaining) / (float)_duration;
         }
 
-        uint16_t _duration;
-        uint16_t _remaining;
+        uint32_t _duration;
+        uint32_t _remaining;
        
         AnimUpdateCallback _fnCallback;
+
+        uint16_t _prev;
+        uint16_t _next;
+        bool _isScheduled;
+        bool _isStarting; // the next update reports AnimationState_Started
+    };
+
+    // the ends of a list of contexts
+    struct AnimationList
+    {
+        uint16_t first;
+        uint16_t last;
     };
 
     uint16_t _countAnimations;
     AnimationContext* _animations;
+    AnimationList _scheduled;
+    AnimationList _free;
     uint32_t _animationLastTick;
     uint16_t _activeAnimations;
     uint16_t _timeScale;
+    NeoAnimatorClock _clock;
     bool _isRunning;
+    bool _isUpdating;
+
+    uint32_t _currentTick() const
+    {
+        return (_clock == NeoAnimatorClock_Micros) ? micros() : millis();
+    }
+
+    void _unlink(AnimationList* pList, uint16_t indexAnimation);
+    void _linkFront(AnimationList* pList, uint16_t indexAnimation);
+    void _linkBack(AnimationList* pList, uint16_t indexAnimation);
 };
@@ -36,114 +36,55 @@ public:
     virtual void SetBrightness(uint8_t brightness) = 0;
 };
 
+// NeoPixelBrightnessBus keeps the pixels at the colors they were set to
+// and scales them on their way to the wire at Show, so changing the
+// brightness costs nothing until then and never loses precision
 template<typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelBrightnessBus : 
     public NeoPixelBus<T_COLOR_FEATURE, T_METHOD>, public NeoPixelBrightnessBusInterface
 {
-private:
-    void ScaleColor(uint16_t scale, typename T_COLOR_FEATURE::ColorObject* color)
-    {
-        uint8_t* ptr = (uint8_t*)color;
-        uint8_t* ptrEnd = ptr + sizeof(typename T_COLOR_FEATURE::ColorObject);
-
-        while (ptr != ptrEnd)
-        {
-            uint16_t value = *ptr;
-            *ptr++ = (value * scale) >> 8;
-        }
-    }
-
-    void ConvertColor(typename T_COLOR_FEATURE::ColorObject* color)
-    {
-        uint16_t scale = _brightness + 1;
-        ScaleColor(scale, color);
-    }
-
-    void RecoverColor(typename T_COLOR_FEATURE::ColorObject* color) const
-    {
-        uint8_t* ptr = (uint8_t*)color;
-        uint8_t* ptrEnd = ptr + sizeof(typename T_COLOR_FEATURE::ColorObject);
-        uint16_t scale = _brightness + 1;
-
-        while (ptr != ptrEnd)
-        {
-            uint16_t value = *ptr;
-            *ptr++ = (value << 8) / scale;
-        }
-    }
-
 public:
     NeoPixelBrightnessBus(uint16_t countPixels, uint8_t pin) :
         NeoPixelBus<T_COLOR_FEATURE, T_METHOD>(countPixels, pin),
-        _brightness(255)
+        _brightness(255),
+        _saved(nullptr)
     {
     }
 
     NeoPixelBrightnessBus(uint16_t countPixels, uint8_t pinClock, uint8_t pinData) :
         NeoPixelBus<T_COLOR_FEATURE, T_METHOD>(countPixels, pinClock, pinData),
-        _brightness(255)
+        _brightness(255),
+        _saved(nullptr)
     {
     }
 
     NeoPixelBrightnessBus(uint16_t countPixels) :
         NeoPixelBus<T_COLOR_FEATURE, T_METHOD>(countPixels),
-        _brightness(255)
+        _brightness(255),
+        _saved(nullptr)
     {
     }
 
-    void SetBrightness(uint8_t brightness) override
+    ~NeoPixelBrightnessBus()
     {
-        // Only update if there is a change
-        if (brightness != _brightness)
-        { 
-            uint16_t scale = (((uint16_t)brightness + 1) << 8) / ((uint16_t)_brightness + 1);
-
-            // scale existing pixels
-            //
-            for (uint16_t indexPixel = 0; indexPixel < NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::PixelCount(); indexPixel++)
-            {
-                typename T_COLOR_FEATURE::ColorObject color = NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::GetPixelColor(indexPixel);
-                ScaleColor(scale, &color);
-                NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::SetPixelColor(indexPixel, color);
-            }
- 
-            _brightness = brightness;
-            this->Dirty();
-        }
+        free(_saved);
     }
 
-    uint8_t GetBrightness() const
-    {
-        return _brightness;
-    }
-
-    void SetPixelColor(uint16_t indexPixel, typename T_COLOR_FEATURE::ColorObject color) override
+    void SetBrightness(uint8_t brightness) override
     {
-        ConvertColor(&color);
-        NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::SetPixelColor(indexPixel, color);
+        _brightness = brightness;
     }
 
-    typename T_COLOR_FEATURE::ColorObject GetPixelColor(uint16_t indexPixel) const override
+    uint8_t GetBrightness() const
     {
-        typename T_COLOR_FEATURE::ColorObject color = NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::GetPixelColor(indexPixel);
-        RecoverColor(&color);
-        return color;
+        return _brightness;
     }
 
-    void ClearTo(typename T_COLOR_FEATURE::ColorObject color)
+    void Show(bool maintainBufferConsistency = true) override
     {
-        ConvertColor(&color);
-        NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::ClearTo(color);
-    };
-
-    void ClearTo(typename T_COLOR_FEATURE::ColorObject color, uint16_t first, uint16_t last)
-    {
-        ConvertColor(&color);
-        NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::ClearTo(color, first, last);
+        this->_showScaled(maintainBufferConsistency, _brightness, _saved);
     }
 
-
 protected:
     uint8_t _brightness;
+    uint8_t* _saved; // the pixels while a dimmed frame is sent, for methods that can't scale
 };
-
-
@@ -44,6 +44,9 @@ License along with NeoPixel.  If not, see
 // '_state' flags for internal state
 #define NEO_DIRTY   0x80 // a change was made to pixel data that requires a show
 
+#include "internal/NeoShowComplete.h"
+#include "internal/NeoBusStats.h"
+#include "internal/NeoOutputScale.h"
 #include "internal/NeoHueBlend.h"
 
 #include "internal/NeoSettings.h"
@@ -54,6 +57,7 @@ License along with NeoPixel.  If not, see
 #include "internal/RgbwColor.h"
 #include "internal/SegmentDigit.h"
 
+#include "internal/NeoElementsCopy.h"
 #include "internal/NeoColorFeatures.h"
 #include "internal/NeoTm1814ColorFeatures.h"
 #include "internal/DotStarColorFeatures.h"
@@ -82,7 +86,16 @@ License along with NeoPixel.  If not, see
 #include "internal/Ws2801GenericMethod.h"
 #include "internal/P9813GenericMethod.h"
 
-#if defined(ARDUINO_ARCH_ESP8266)
+#if defined(NEOPIXELBUS_HOST) // must be first as the host compiler may define __arm__
+
+#include "internal/NeoHostMethod.h"
+
+// platform neutral wire encoders, included so they can be benchmarked
+#include "internal/NeoEsp32I2sEncoders.h"
+#include "internal/NeoEsp32RmtTranslators.h"
+#include "internal/NeoEsp8266Encoders.h"
+
+#elif defined(ARDUINO_ARCH_ESP8266)
 
 #include "internal/NeoEsp8266DmaMethod.h"
 #include "internal/NeoEsp8266UartMethod.h"
@@ -91,6 +104,7 @@ License along with NeoPixel.  If not, see
 #elif defined(ARDUINO_ARCH_ESP32)
 
 #include "internal/NeoEsp32I2sMethod.h"
+#include "internal/NeoEsp32I2sParallelMethod.h"
 #include "internal/NeoEsp32RmtMethod.h"
 #include "internal/NeoEspBitBangMethod.h"
 
@@ -123,7 +137,9 @@ public:
     virtual typename T_COLOR_FEATURE::ColorObject GetPixelColor(uint16_t indexPixel) const = 0;
 };
 
-template<typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelBus : public NeoPixelBusInterface<T_COLOR_FEATURE>
+// T_STATS is NeoNoStats or NeoFrameStats
+template<typename T_COLOR_FEATURE, typename T_METHOD, typename T_STATS = NeoNoStats> class NeoPixelBus :
+    public NeoPixelBusInterface<T_COLOR_FEATURE>
 {
 public:
     // Constructor: number of LEDs, pin number
@@ -132,21 +148,36 @@ public:
     NeoPixelBus(uint16_t countPixels, uint8_t pin) :
         _countPixels(countPixels),
         _state(0),
-        _method(pin, countPixels, T_COLOR_FEATURE::PixelSize, T_COLOR_FEATURE::SettingsSize)
+        _dirtyFirst(0),
+        _dirtyLast(0),
+        _method(pin, countPixels, T_COLOR_FEATURE::PixelSize, T_COLOR_FEATURE::SettingsSize),
+        _showComplete(nullptr),
+        _showCompleteContext(nullptr),
+        _outputScale(NeoOutputScaleNone)
     {
     }
 
     NeoPixelBus(uint16_t countPixels, uint8_t pinClock, uint8_t pinData) :
         _countPixels(countPixels),
         _state(0),
-        _method(pinClock, pinData, countPixels, T_COLOR_FEATURE::PixelSize, T_COLOR_FEATURE::SettingsSize)
+        _dirtyFirst(0),
+        _dirtyLast(0),
+        _method(pinClock, pinData, countPixels, T_COLOR_FEATURE::PixelSize, T_COLOR_FEATURE::SettingsSize),
+        _showComplete(nullptr),
+        _showCompleteContext(nullptr),
+        _outputScale(NeoOutputScaleNone)
     {
     }
 
     NeoPixelBus(uint16_t countPixels) :
         _countPixels(countPixels),
         _state(0),
-        _method(countPixels, T_COLOR_FEATURE::PixelSize, T_COLOR_FEATURE::SettingsSize)
+        _dirtyFirst(0),
+        _dirtyLast(0),
+        _method(countPixels, T_COLOR_FEATURE::PixelSize, T_COLOR_FEATURE::SettingsSize),
+        _showComplete(nullptr),
+        _showCompleteContext(nullptr),
+        _outputScale(NeoOutputScaleNone)
     {
     }
 
@@ -175,19 +206,107 @@ public:
     {
         if (!IsDirty())
         {
+            _stats.OnSkippedShow();
             return;
         }
 
-        _method.Update(maintainBufferConsistency);
+        if (T_STATS::Enabled)
+        {
+            // wait here rather than in the method so it can be timed apart
+            uint32_t waitStart = _stats.Now();
+            while (!_methodIsWriteDone(_method, 0))
+            {
+                yield();
+            }
+            _stats.OnWait(waitStart, _stats.Now());
+        }
+
+        // settings are always in front of the pixels, so a range that
+        // starts at the first pixel includes them
+        size_t dirtyStart = 0;
+        if (_dirtyFirst != 0)
+        {
+            dirtyStart = T_COLOR_FEATURE::SettingsSize + _dirtyFirst * T_COLOR_FEATURE::PixelSize;
+        }
+        size_t dirtyEnd = T_COLOR_FEATURE::SettingsSize + (_dirtyLast + 1) * T_COLOR_FEATURE::PixelSize;
+        if (dirtyEnd > _method.getDataSize())
+        {
+            dirtyEnd = _method.getDataSize();
+        }
+
+        uint32_t updateStart = _stats.Now();
+        _methodUpdate(_method, maintainBufferConsistency, dirtyStart, dirtyEnd - dirtyStart, 0);
+        _stats.OnUpdate(updateStart,
+            _stats.Now(),
+            T_STATS::Enabled ? _methodUnderrunCount(_method, 0) : 0);
 
         ResetDirty();
     }
 
+    // starts sending without waiting on the wire; returns false and does
+    // nothing while the previous send is still going.  callback(context)
+    // is called once this send is done, from the interrupt on methods that
+    // signal completion, otherwise from the first Poll or ShowAsync that
+    // finds the method ready
+    bool ShowAsync(NeoShowCompleteCallback callback, void* context = nullptr, bool maintainBufferConsistency = true)
+    {
+        if (!Poll())
+        {
+            return false;
+        }
+
+        if (!IsDirty())
+        {
+            // nothing to send
+            if (callback != nullptr)
+            {
+                callback(context);
+            }
+            return true;
+        }
+
+        // set before the update so a quick send can't finish unnoticed
+        if (!_methodSetCompleteCallback(_method, callback, context, 0))
+        {
+            _showComplete = callback;
+            _showCompleteContext = context;
+        }
+
+        Show(maintainBufferConsistency);
+
+        // methods that send synchronously are already done
+        Poll();
+        return true;
+    }
+
     inline bool CanShow() const override
     { 
-        return _method.IsReadyToUpdate();
+        bool ready = _method.IsReadyToUpdate();
+
+        if (ready)
+        {
+            _stats.OnReady(_stats.Now());
+        }
+        return ready;
     };
 
+    // same as CanShow, and on methods that don't signal completion it
+    // calls the pending ShowAsync callback once the send is done, so call
+    // it from the loop while waiting on one
+    bool Poll()
+    {
+        bool ready = CanShow();
+
+        if (ready && _showComplete != nullptr)
+        {
+            NeoShowCompleteCallback callback = _showComplete;
+
+            _showComplete = nullptr;
+            callback(_showCompleteContext);
+        }
+        return ready;
+    }
+
     bool IsDirty() const
     {
         return  (_state & NEO_DIRTY);
@@ -195,7 +314,46 @@ public:
 
     void Dirty()
     {
-        _state |= NEO_DIRTY;
+        Dirty(0, (_countPixels != 0) ? _countPixels - 1 : 0);
+    };
+
+    // marks only the pixels from first to last as changed, so methods
+    // that support it only re-encode those on the next Show; last is
+    // clamped to the end and a range that is empty is ignored
+    void Dirty(uint16_t first, uint16_t last)
+    {
+        if (_countPixels == 0)
+        {
+            // only the settings are sent
+            first = 0;
+            last = 0;
+        }
+        else if (last >= _countPixels)
+        {
+            last = _countPixels - 1;
+        }
+        if (first > last)
+        {
+            return;
+        }
+
+        if (!IsDirty())
+        {
+            _dirtyFirst = first;
+            _dirtyLast = last;
+            _state |= NEO_DIRTY;
+        }
+        else
+        {
+            if (first < _dirtyFirst)
+            {
+                _dirtyFirst = first;
+            }
+            if (last > _dirtyLast)
+            {
+                _dirtyLast = last;
+            }
+        }
     };
 
     void ResetDirty()
@@ -228,7 +386,7 @@ public:
         if (indexPixel < _countPixels)
         {
             T_COLOR_FEATURE::applyPixelColor(_pixels(), indexPixel, color);
-            Dirty();
+            Dirty(indexPixel, indexPixel);
         }
     };
 
@@ -246,6 +404,42 @@ public:
         }
     };
 
+    // sets count pixels from first on to the colors in pColors, as one
+    // span marked dirty once; pixels past the end are ignored
+    void SetPixels(uint16_t first, const typename T_COLOR_FEATURE::ColorObject* pColors, uint16_t count)
+    {
+        count = _clampSpan(first, count);
+        if (count != 0)
+        {
+            uint8_t* pFront = T_COLOR_FEATURE::getPixelAddress(_pixels(), first);
+
+            for (uint16_t index = 0; index < count; index++)
+            {
+                T_COLOR_FEATURE::applyPixelColor(pFront, index, pColors[index]);
+            }
+
+            Dirty(first, first + count - 1);
+        }
+    }
+
+    // sets count pixels from first on from raw pixel data laid out as
+    // T_SOURCE_FEATURE stores it, like the RGB triples of NeoRgbFeature;
+    // when it is the feature of the bus the data is copied as is
+    //
+    // strip.SetPixelsRaw<NeoRgbFeature>(0, frame, frameCount);
+    template <typename T_SOURCE_FEATURE> void SetPixelsRaw(uint16_t first, const uint8_t* pSource, uint16_t count)
+    {
+        count = _clampSpan(first, count);
+        if (count != 0)
+        {
+            uint8_t* pFront = T_COLOR_FEATURE::getPixelAddress(_pixels(), first);
+
+            _convertPixels(pFront, pSource, count, static_cast<const T_SOURCE_FEATURE*>(nullptr));
+
+            Dirty(first, first + count - 1);
+        }
+    }
+
     void ClearTo(typename T_COLOR_FEATURE::ColorObject color)
     {
         uint8_t temp[T_COLOR_FEATURE::PixelSize]; 
@@ -272,7 +466,7 @@ public:
 
             T_COLOR_FEATURE::replicatePixel(pFront, temp, last - first + 1);
 
-            Dirty();
+            Dirty(first, last);
         }
     }
 
@@ -300,7 +494,7 @@ public:
         if ((_countPixels - 1) >= shiftCount)
         {
             _shiftLeft(shiftCount, 0, _countPixels - 1);
-            Dirty();
+            Dirty(0, _countPixels - 1);
         }
     }
 
@@ -312,7 +506,7 @@ public:
             (last - first) >= shiftCount)
         {
             _shiftLeft(shiftCount, first, last);
-            Dirty();
+            Dirty(first, last);
         }
     }
 
@@ -340,7 +534,7 @@ public:
         if ((_countPixels - 1) >= shiftCount)
         {
             _shiftRight(shiftCount, 0, _countPixels - 1);
-            Dirty();
+            Dirty(0, _countPixels - 1);
         }
     }
 
@@ -352,7 +546,7 @@ public:
             (last - first) >= shiftCount)
         {
             _shiftRight(shiftCount, first, last);
-            Dirty();
+            Dirty(first, last);
         }
     }
     
@@ -368,9 +562,15 @@ public:
     void SetPixelSettings(const typename T_COLOR_FEATURE::SettingsObject& settings)
     {
         T_COLOR_FEATURE::applySettings(_method.getData(), settings);
-        Dirty();
+        Dirty(0, 0); // settings are sent in front of the first pixel
     };
  
+    // all zero with NeoNoStats
+    NeoBusStats Stats() const
+    {
+        return _stats.Stats();
+    }
+
     uint32_t CalcTotalMilliAmpere(const typename T_COLOR_FEATURE::ColorObject::SettingsObject& settings)
     {
         uint32_t total = 0; // in 1/10th milliamps
@@ -388,8 +588,216 @@ protected:
     const uint16_t _countPixels; // Number of RGB LEDs in strip
 
     uint8_t _state;     // internal state
+    mutable T_STATS _stats; // empty unless enabled, fits in the padding after _state
+    uint16_t _dirtyFirst; // first pixel changed since the last show
+    uint16_t _dirtyLast;  // last pixel changed since the last show
     T_METHOD _method;
 
+    // ShowAsync completion for methods without their own
+    NeoShowCompleteCallback _showComplete;
+    void* _showCompleteContext;
+
+    uint16_t _outputScale; // the scale of the last _showScaled
+
+    // methods that can signal the end of a send implement
+    // SetCompleteCallback(callback, context), all others are polled
+    template <typename T> static auto _methodSetCompleteCallback(T& method,
+        NeoShowCompleteCallback callback,
+        void* context,
+        int) -> decltype(method.SetCompleteCallback(callback, context), bool())
+    {
+        method.SetCompleteCallback(callback, context);
+        return true;
+    }
+
+    template <typename T> static bool _methodSetCompleteCallback(T&,
+        NeoShowCompleteCallback,
+        void*,
+        long)
+    {
+        return false;
+    }
+
+    // methods that can scale the data as they encode it implement
+    // SetOutputScale(scale), returning false if they can't in their
+    // current configuration
+    template <typename T> static auto _methodSetOutputScale(T& method,
+        uint16_t scale,
+        int) -> decltype(static_cast<bool>(method.SetOutputScale(scale)))
+    {
+        return method.SetOutputScale(scale);
+    }
+
+    template <typename T> static bool _methodSetOutputScale(T&,
+        uint16_t,
+        long)
+    {
+        return false;
+    }
+
+    // methods that can send the pixels rotated as they encode them
+    // implement SetOutputRotation(rotation) in bytes
+    template <typename T> static auto _methodSetOutputRotation(T& method,
+        size_t rotation,
+        int) -> decltype(static_cast<bool>(method.SetOutputRotation(rotation)))
+    {
+        return method.SetOutputRotation(rotation);
+    }
+
+    template <typename T> static bool _methodSetOutputRotation(T&,
+        size_t,
+        long)
+    {
+        return false;
+    }
+
+    // methods that can detect their interrupt falling behind implement
+    // UnderrunCount()
+    template <typename T> static auto _methodUnderrunCount(const T& method,
+        int) -> decltype(static_cast<uint32_t>(method.UnderrunCount()))
+    {
+        return method.UnderrunCount();
+    }
+
+    template <typename T> static uint32_t _methodUnderrunCount(const T&,
+        long)
+    {
+        return 0;
+    }
+
+    // methods that hold an update until the other outputs they send with
+    // are updated too are not ready while it is held, yet updating again
+    // sends it; they implement IsWriteDone() for the wire alone so a wait
+    // before the update can't spin forever
+    template <typename T> static auto _methodIsWriteDone(const T& method,
+        int) -> decltype(static_cast<bool>(method.IsWriteDone()))
+    {
+        return method.IsWriteDone();
+    }
+
+    template <typename T> static bool _methodIsWriteDone(const T& method,
+        long)
+    {
+        return method.IsReadyToUpdate();
+    }
+
+    // methods that keep an encoded copy of the data stream may implement
+    // Update(bool, dirtyOffset, dirtySize) to only re-encode the changed bytes,
+    // all others get the plain Update(bool)
+    template <typename T> static auto _methodUpdate(T& method,
+        bool maintainBufferConsistency,
+        size_t dirtyOffset,
+        size_t dirtySize,
+        int) -> decltype(method.Update(maintainBufferConsistency, dirtyOffset, dirtySize))
+    {
+        return method.Update(maintainBufferConsistency, dirtyOffset, dirtySize);
+    }
+
+    template <typename T> static void _methodUpdate(T& method,
+        bool maintainBufferConsistency,
+        size_t,
+        size_t,
+        long)
+    {
+        method.Update(maintainBufferConsistency);
+    }
+
+    // methods whose Update can return before the pixels are read, as they
+    // are only sent along with other outputs, declare DefersPixelRead;
+    // pixels converted for one Show must not be restored on them
+    template <typename T> static constexpr auto _methodDefersPixelRead(int)
+        -> decltype(static_cast<bool>(T::DefersPixelRead))
+    {
+        return T::DefersPixelRead;
+    }
+
+    template <typename T> static constexpr bool _methodDefersPixelRead(long)
+    {
+        return false;
+    }
+
+    // sends the pixels dimmed by ratio (255 is unchanged) without changing
+    // them; methods that implement SetOutputScale scale as they encode,
+    // for all others the pixels are dimmed and restored by _showDimmed,
+    // which allocates pSaved the first time it is needed; if that can't
+    // be done the pixels are sent undimmed
+    void _showScaled(bool maintainBufferConsistency, uint8_t ratio, uint8_t*& pSaved)
+    {
+        uint16_t scale = static_cast<uint16_t>(ratio) + 1;
+
+        if (scale != _outputScale)
+        {
+            // every byte the method encoded changes
+            Dirty();
+        }
+
+        if (!IsDirty())
+        {
+            NeoPixelBus::Show(maintainBufferConsistency);
+            return;
+        }
+
+        if (_methodSetOutputScale(_method, scale, 0) || scale == NeoOutputScaleNone)
+        {
+            NeoPixelBus::Show(maintainBufferConsistency);
+        }
+        else
+        {
+            if (pSaved == nullptr && !_methodDefersPixelRead<T_METHOD>(0))
+            {
+                pSaved = static_cast<uint8_t*>(malloc(PixelsSize()));
+            }
+
+            if (pSaved == nullptr)
+            {
+                // the method reads the pixels after Show returns, when they
+                // are restored, or there is no memory to restore them from;
+                // send them undimmed and try again on the next Show
+                NeoPixelBus::Show(maintainBufferConsistency);
+                _outputScale = NeoOutputScaleNone;
+                return;
+            }
+            _showDimmed(maintainBufferConsistency, ratio, pSaved);
+        }
+        _outputScale = scale;
+    }
+
+    // sends the pixels dimmed by ratio (255 is unchanged) but leaves them
+    // as they were; pSaved is a scratch buffer of PixelsSize() bytes
+    void _showDimmed(bool maintainBufferConsistency, uint8_t ratio, uint8_t* pSaved)
+    {
+        _showConverted(maintainBufferConsistency, pSaved, [this, ratio](uint8_t* pixels)
+        {
+            for (uint16_t indexPixel = 0; indexPixel < _countPixels; indexPixel++)
+            {
+                typename T_COLOR_FEATURE::ColorObject color = T_COLOR_FEATURE::retrievePixelColor(pixels, indexPixel);
+                T_COLOR_FEATURE::applyPixelColor(pixels, indexPixel, color.Dim(ratio));
+            }
+        });
+    }
+
+    // sends the pixels as changed by fnConvert(pixels) but leaves them as
+    // they were; pSaved is a scratch buffer of PixelsSize() bytes.
+    // The whole frame is sent so the encoded copy a method may keep
+    // never mixes converted and unconverted pixels.  Not for methods
+    // that declare DefersPixelRead
+    template <typename T_CONVERT> void _showConverted(bool maintainBufferConsistency,
+        uint8_t* pSaved,
+        T_CONVERT fnConvert)
+    {
+        uint8_t* pixels = _pixels();
+
+        memcpy(pSaved, pixels, PixelsSize());
+        fnConvert(pixels);
+
+        Dirty();
+        NeoPixelBus::Show(maintainBufferConsistency);
+
+        // double buffered methods may have swapped, so restore into
+        // whatever buffer is now the one being edited
+        memcpy(_pixels(), pSaved, PixelsSize());
+    }
+
     uint8_t* _pixels()
     {
         // get pixels data within the data stream
@@ -402,24 +810,47 @@ protected:
         return T_COLOR_FEATURE::pixels(_method.getData());
     }
 
-    void _rotateLeft(uint16_t rotationCount, uint16_t first, uint16_t last)
+    // the count of a span from first that lies within the pixels
+    uint16_t _clampSpan(uint16_t first, uint16_t count) const
     {
-        // store in temp
-        uint8_t temp[rotationCount * T_COLOR_FEATURE::PixelSize];
-        uint8_t* pixels = _pixels();
+        if (first >= _countPixels)
+        {
+            return 0;
+        }
+        return (count > _countPixels - first) ? _countPixels - first : count;
+    }
 
-        uint8_t* pFront = T_COLOR_FEATURE::getPixelAddress(pixels, first);
+    // the source is another feature, so each pixel goes through its color
+    template <typename T_SOURCE_FEATURE> static void _convertPixels(uint8_t* pDest,
+        const uint8_t* pSource,
+        uint16_t count,
+        const T_SOURCE_FEATURE*)
+    {
+        for (uint16_t index = 0; index < count; index++)
+        {
+            T_COLOR_FEATURE::applyPixelColor(pDest, index, T_SOURCE_FEATURE::retrievePixelColor(pSource, index));
+        }
+    }
 
-        T_COLOR_FEATURE::movePixelsInc(temp, pFront, rotationCount);
+    // the source is already in the order of the bus; it is the caller's
+    // and may have any alignment, which the word copies of the four byte
+    // features would fault on
+    static void _convertPixels(uint8_t* pDest,
+        const uint8_t* pSource,
+        uint16_t count,
+        const T_COLOR_FEATURE*)
+    {
+        memmove(pDest, pSource, count * T_COLOR_FEATURE::PixelSize);
+    }
 
-        // shift data
-        _shiftLeft(rotationCount, first, last);
+    void _rotateLeft(uint16_t rotationCount, uint16_t first, uint16_t last)
+    {
+        // in place, so any count is safe on a small stack
+        uint8_t* pFront = T_COLOR_FEATURE::getPixelAddress(_pixels(), first);
 
-        // move temp back
-        pFront = T_COLOR_FEATURE::getPixelAddress(pixels, last - (rotationCount - 1));
-        T_COLOR_FEATURE::movePixelsInc(pFront, temp, rotationCount);
+        T_COLOR_FEATURE::rotatePixelsLeft(pFront, last - first + 1, rotationCount);
 
-        Dirty();
+        Dirty(first, last);
     }
 
     void _shiftLeft(uint16_t shiftCount, uint16_t first, uint16_t last)
@@ -438,22 +869,13 @@ protected:
 
     void _rotateRight(uint16_t rotationCount, uint16_t first, uint16_t last)
     {
-        // store in temp
-        uint8_t temp[rotationCount * T_COLOR_FEATURE::PixelSize];
-        uint8_t* pixels = _pixels();
-
-        uint8_t* pFront = T_COLOR_FEATURE::getPixelAddress(pixels, last - (rotationCount - 1));
-
-        T_COLOR_FEATURE::movePixelsDec(temp, pFront, rotationCount);
+        uint16_t count = last - first + 1;
+        uint8_t* pFront = T_COLOR_FEATURE::getPixelAddress(_pixels(), first);
 
-        // shift data
-        _shiftRight(rotationCount, first, last);
+        // right by some is left by the rest
+        T_COLOR_FEATURE::rotatePixelsLeft(pFront, count, count - rotationCount);
 
-        // move temp back
-        pFront = T_COLOR_FEATURE::getPixelAddress(pixels, first);
-        T_COLOR_FEATURE::movePixelsDec(pFront, temp, rotationCount);
-
-        Dirty();
+        Dirty(first, last);
     }
 
     void _shiftRight(uint16_t shiftCount, uint16_t first, uint16_t last)
@@ -0,0 +1,213 @@
+/*-------------------------------------------------------------------------
+NeoPixelBus library wrapper template class that renders into a triple
+buffered frame queue and sends the newest frame from an output task
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "NeoPixelBus.h"
+#include "internal/NeoFrameQueue.h"
+
+// NeoPixelBusFrameQueue decouples the render rate from the wire rate.
+// The pixel functions work on the back frame of a NeoFrameQueue and Show
+// only publishes it, it never waits for the wire.  The output side takes
+// the newest published frame, dropping any it never got to, and shows it
+// on the wrapped NeoPixelBus.  On the ESP32 Begin starts an output task
+// pinned to the other core; elsewhere call Process from the output loop
+template<typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelBusFrameQueue :
+    public NeoPixelBusInterface<T_COLOR_FEATURE>
+{
+public:
+    NeoPixelBusFrameQueue(uint16_t countPixels, uint8_t pin) :
+        _bus(countPixels, pin),
+        _frames(countPixels * T_COLOR_FEATURE::PixelSize)
+    {
+    }
+
+    NeoPixelBusFrameQueue(uint16_t countPixels, uint8_t pinClock, uint8_t pinData) :
+        _bus(countPixels, pinClock, pinData),
+        _frames(countPixels * T_COLOR_FEATURE::PixelSize)
+    {
+    }
+
+    ~NeoPixelBusFrameQueue()
+    {
+#if defined(ARDUINO_ARCH_ESP32)
+        if (_task != nullptr)
+        {
+            // ask the output task to exit and wait until it has
+            _owner = xTaskGetCurrentTaskHandle();
+            _running = false;
+            xTaskNotifyGive(_task);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+#endif
+    }
+
+    void Begin() override
+    {
+#if defined(ARDUINO_ARCH_ESP32)
+        // the bus is started along with the task, only once
+        Begin((xPortGetCoreID() == 0) ? 1 : 0, 1);
+#else
+        _bus.Begin();
+#endif
+    }
+
+#if defined(ARDUINO_ARCH_ESP32)
+    // starts the bus and the output task on the given core, Begin() picks
+    // the core the caller is not running on; calling it again does nothing
+    void Begin(BaseType_t core, UBaseType_t priority)
+    {
+        if (_task == nullptr)
+        {
+            _bus.Begin();
+            _running = true;
+            xTaskCreatePinnedToCore(_outputTask, "NeoOutput", 3072, this, priority, &_task, core);
+        }
+    }
+#endif
+
+    // publishes the back frame, the newest published frame is sent next;
+    // with maintainBufferConsistency the new back frame starts as a copy
+    // of the published one
+    void Show(bool maintainBufferConsistency = true) override
+    {
+        const uint8_t* published = _frames.Publish();
+
+        if (maintainBufferConsistency)
+        {
+            memcpy(_frames.Back(), published, _frames.FrameSize());
+        }
+
+#if defined(ARDUINO_ARCH_ESP32)
+        if (_task != nullptr)
+        {
+            xTaskNotifyGive(_task);
+        }
+#endif
+    }
+
+    // Show never waits
+    bool CanShow() const override
+    {
+        return true;
+    }
+
+    // output side, shows the newest published frame if there is one;
+    // returns false when there was none
+    bool Process()
+    {
+        if (!_frames.Acquire())
+        {
+            return false;
+        }
+
+        memcpy(_bus.Pixels(), _frames.Front(), _frames.FrameSize());
+        _bus.Dirty();
+        _bus.Show(false);
+        return true;
+    }
+
+    // output side bus, for SetPixelSettings and the like before Begin
+    NeoPixelBus<T_COLOR_FEATURE, T_METHOD>& Bus()
+    {
+        return _bus;
+    }
+
+    uint8_t* Pixels()
+    {
+        return _frames.Back();
+    }
+
+    size_t PixelsSize() const
+    {
+        return _frames.FrameSize();
+    }
+
+    size_t PixelSize() const
+    {
+        return T_COLOR_FEATURE::PixelSize;
+    }
+
+    uint16_t PixelCount() const
+    {
+        return _bus.PixelCount();
+    }
+
+    void SetPixelColor(uint16_t indexPixel, typename T_COLOR_FEATURE::ColorObject color) override
+    {
+        if (indexPixel < PixelCount())
+        {
+            T_COLOR_FEATURE::applyPixelColor(_frames.Back(), indexPixel, color);
+        }
+    }
+
+    typename T_COLOR_FEATURE::ColorObject GetPixelColor(uint16_t indexPixel) const override
+    {
+        if (indexPixel < PixelCount())
+        {
+            return T_COLOR_FEATURE::retrievePixelColor(_frames.Back(), indexPixel);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    void ClearTo(typename T_COLOR_FEATURE::ColorObject color)
+    {
+        uint8_t temp[T_COLOR_FEATURE::PixelSize];
+
+        T_COLOR_FEATURE::applyPixelColor(temp, 0, color);
+        T_COLOR_FEATURE::replicatePixel(_frames.Back(), temp, PixelCount());
+    }
+
+private:
+    NeoPixelBus<T_COLOR_FEATURE, T_METHOD> _bus;
+    NeoFrameQueue _frames;
+
+#if defined(ARDUINO_ARCH_ESP32)
+    TaskHandle_t _task = nullptr;
+    TaskHandle_t _owner = nullptr;
+    volatile bool _running = false;
+
+    static void _outputTask(void* param)
+    {
+        NeoPixelBusFrameQueue* self = static_cast<NeoPixelBusFrameQueue*>(param);
+
+        while (self->_running)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            while (self->_running && self->Process())
+            {
+            }
+        }
+
+        xTaskNotifyGive(self->_owner);
+        vTaskDelete(nullptr);
+    }
+#endif
+};
@@ -0,0 +1,240 @@
+/*-------------------------------------------------------------------------
+NeoPixelBus library wrapper template class that gamma corrects the pixels
+at Show through per channel 16 bit tables with temporal dithering
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "NeoPixelBus.h"
+
+// the color objects NeoPixelGammaBus knows the full white of
+template<typename T_COLOR> class NeoGammaBusColor
+{
+public:
+    static const bool Supported = false;
+};
+
+template<> class NeoGammaBusColor<RgbColor>
+{
+public:
+    static const bool Supported = true;
+};
+
+template<> class NeoGammaBusColor<RgbwColor>
+{
+public:
+    static const bool Supported = true;
+};
+
+// NeoPixelGammaBus keeps the pixels at the colors they were set to and
+// gamma corrects them on their way to the wire at Show.  Every byte of a
+// pixel has its own NeoGamma16Table, so each channel can have its own white
+// level.  With dithering on, the fraction the 8 bit output drops is carried
+// to the next frame of the same byte, so over frames the average is the
+// 16 bit value; Show then sends every call and should be called every frame.
+// The corrected frame is sent and the pixels restored within Show, so
+// methods that read the pixels after Show returns (DefersPixelRead) can't
+// be used.  Without the memory for the two frame sized buffers it needs,
+// Show sends the pixels uncorrected
+template<typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelGammaBus :
+    public NeoPixelBus<T_COLOR_FEATURE, T_METHOD>
+{
+public:
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    static_assert(NeoGammaBusColor<ColorObject>::Supported,
+        "NeoPixelGammaBus supports the features of RgbColor and RgbwColor");
+    static_assert(!NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::template _methodDefersPixelRead<T_METHOD>(0),
+        "NeoPixelGammaBus can't use a method that reads the pixels after Show returns");
+
+    NeoPixelGammaBus(uint16_t countPixels, uint8_t pin) :
+        NeoPixelBus<T_COLOR_FEATURE, T_METHOD>(countPixels, pin)
+    {
+        _construct();
+    }
+
+    NeoPixelGammaBus(uint16_t countPixels, uint8_t pinClock, uint8_t pinData) :
+        NeoPixelBus<T_COLOR_FEATURE, T_METHOD>(countPixels, pinClock, pinData)
+    {
+        _construct();
+    }
+
+    NeoPixelGammaBus(uint16_t countPixels) :
+        NeoPixelBus<T_COLOR_FEATURE, T_METHOD>(countPixels)
+    {
+        _construct();
+    }
+
+    ~NeoPixelGammaBus()
+    {
+        free(_saved);
+        free(_error);
+    }
+
+    // the default matches NeoEase::Gamma and NeoGammaTableMethod
+    void SetGamma(float gamma)
+    {
+        _gamma = gamma;
+        _build();
+    }
+
+    // the color that is sent for full white
+    void SetWhiteBalance(const ColorObject& white)
+    {
+        _white = white;
+        _build();
+    }
+
+    void SetDithering(bool dithering)
+    {
+        _dithering = dithering;
+        if (_error != nullptr)
+        {
+            memset(_error, 0, this->PixelsSize());
+        }
+        this->Dirty();
+    }
+
+    void Show(bool maintainBufferConsistency = true) override
+    {
+        if ((!_dithering && !this->IsDirty()) || _saved == nullptr)
+        {
+            NeoPixelBus<T_COLOR_FEATURE, T_METHOD>::Show(maintainBufferConsistency);
+            return;
+        }
+
+        this->_showConverted(maintainBufferConsistency, _saved, [this](uint8_t* pixels)
+        {
+            if (_dithering)
+            {
+                _correctDithered(pixels);
+            }
+            else
+            {
+                _correctRounded(pixels);
+            }
+        });
+    }
+
+protected:
+    NeoGamma16Table _tables[T_COLOR_FEATURE::PixelSize];
+    float _gamma;
+    ColorObject _white;
+    bool _dithering;
+    uint8_t* _saved; // the pixels while the corrected frame is sent
+    uint8_t* _error; // the fraction of every byte carried to the next frame
+
+    void _construct()
+    {
+        _gamma = 1.0f / 0.45f;
+        _white = _fullWhite(ColorObject(0));
+        _dithering = true;
+        _saved = static_cast<uint8_t*>(malloc(this->PixelsSize()));
+        _error = static_cast<uint8_t*>(malloc(this->PixelsSize()));
+        if (_saved == nullptr || _error == nullptr)
+        {
+            // Show sends the pixels uncorrected
+            free(_saved);
+            free(_error);
+            _saved = nullptr;
+            _error = nullptr;
+        }
+        else
+        {
+            memset(_error, 0, this->PixelsSize());
+        }
+        _build();
+    }
+
+    // a byte that is 0 for black and 255 for full white is a color; any
+    // other (a DotStar header or luminance) is sent through unchanged
+    // by a linear table
+    void _build()
+    {
+        uint8_t black[T_COLOR_FEATURE::PixelSize];
+        uint8_t full[T_COLOR_FEATURE::PixelSize];
+        uint8_t white[T_COLOR_FEATURE::PixelSize];
+
+        T_COLOR_FEATURE::applyPixelColor(black, 0, ColorObject(0));
+        T_COLOR_FEATURE::applyPixelColor(full, 0, _fullWhite(ColorObject(0)));
+        T_COLOR_FEATURE::applyPixelColor(white, 0, _white);
+
+        for (size_t element = 0; element < T_COLOR_FEATURE::PixelSize; element++)
+        {
+            if (black[element] == 0 && full[element] == 255)
+            {
+                _tables[element].Build(_gamma, white[element]);
+            }
+            else
+            {
+                _tables[element].Build(1.0f);
+            }
+        }
+
+        // every byte sent changes
+        this->Dirty();
+    }
+
+    static RgbColor _fullWhite(const RgbColor&)
+    {
+        return RgbColor(255, 255, 255);
+    }
+
+    static RgbwColor _fullWhite(const RgbwColor&)
+    {
+        return RgbwColor(255, 255, 255, 255);
+    }
+
+    void _correctDithered(uint8_t* pixels)
+    {
+        uint8_t* pError = _error;
+        uint8_t* pEnd = pixels + this->PixelsSize();
+
+        while (pixels < pEnd)
+        {
+            for (size_t element = 0; element < T_COLOR_FEATURE::PixelSize; element++)
+            {
+                // the tables top out at 255.0 so this never overflows
+                uint16_t value = _tables[element].Correct(*pixels) + *pError;
+                *(pixels++) = static_cast<uint8_t>(value >> 8);
+                *(pError++) = static_cast<uint8_t>(value);
+            }
+        }
+    }
+
+    void _correctRounded(uint8_t* pixels)
+    {
+        uint8_t* pEnd = pixels + this->PixelsSize();
+
+        while (pixels < pEnd)
+        {
+            for (size_t element = 0; element < T_COLOR_FEATURE::PixelSize; element++)
+            {
+                *(pixels) = static_cast<uint8_t>((_tables[element].Correct(*pixels) + 128) >> 8);
+                pixels++;
+            }
+        }
+    }
+};
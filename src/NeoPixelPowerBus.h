@@ -0,0 +1,257 @@
+/*-------------------------------------------------------------------------
+NeoPixelBus library wrapper template class that keeps a running total of
+the current drawn by the pixels and limits it at Show
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "NeoPixelBus.h"
+
+// NeoPixelPowerBus updates the total current by the change of every pixel
+// set, cleared or shifted, so CalcTotalMilliAmpere is O(1).  Writing the
+// pixels directly (Pixels(), Blt, Render) makes it walk the pixels once on
+// the next query.  With a budget set, Show scales the frame sent so its
+// current stays under the budget; the pixels themselves keep their colors.
+// Only SetPixelColor and Show are virtual, the other functions here hide
+// those of NeoPixelBus, so writes made through a NeoPixelBus reference
+// miss the total; call Pixels() after them so the next query walks the
+// pixels again
+template<typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelPowerBus :
+    public NeoPixelBus<T_COLOR_FEATURE, T_METHOD>
+{
+public:
+    typedef NeoPixelBus<T_COLOR_FEATURE, T_METHOD> Base;
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+    typedef typename T_COLOR_FEATURE::ColorObject::SettingsObject SettingsObject;
+
+    NeoPixelPowerBus(uint16_t countPixels, uint8_t pin, const SettingsObject& settings) :
+        Base(countPixels, pin),
+        _settings(settings)
+    {
+    }
+
+    NeoPixelPowerBus(uint16_t countPixels, uint8_t pinClock, uint8_t pinData, const SettingsObject& settings) :
+        Base(countPixels, pinClock, pinData),
+        _settings(settings)
+    {
+    }
+
+    NeoPixelPowerBus(uint16_t countPixels, const SettingsObject& settings) :
+        Base(countPixels),
+        _settings(settings)
+    {
+    }
+
+    ~NeoPixelPowerBus()
+    {
+        free(_saved);
+    }
+
+    operator NeoBufferContext<T_COLOR_FEATURE>()
+    {
+        _stale = true;
+        return Base::operator NeoBufferContext<T_COLOR_FEATURE>();
+    }
+
+    uint8_t* Pixels()
+    {
+        _stale = true;
+        return Base::Pixels();
+    }
+
+    void SetPowerSettings(const SettingsObject& settings)
+    {
+        _settings = settings;
+        _stale = true;
+    }
+
+    // the most the frame sent may draw, 0 for no limit
+    void SetPowerBudget(uint32_t milliAmpere)
+    {
+        if (_budgetTenthMilliAmpere != milliAmpere * 10)
+        {
+            _budgetTenthMilliAmpere = milliAmpere * 10;
+            this->Dirty();
+        }
+    }
+
+    using Base::CalcTotalMilliAmpere;
+
+    // the current of the pixels as set, before any limit
+    uint32_t CalcTotalMilliAmpere()
+    {
+        return _total() / 10;
+    }
+
+    // the dim ratio Show applies to stay within the budget, 255 when
+    // the pixels are within it
+    uint8_t CalcLimitRatio()
+    {
+        uint32_t total = _total();
+
+        if (_budgetTenthMilliAmpere == 0 || total <= _budgetTenthMilliAmpere)
+        {
+            return 255;
+        }
+
+        // Dim scales by (ratio + 1) / 256
+        uint32_t scale = static_cast<uint32_t>((static_cast<uint64_t>(_budgetTenthMilliAmpere) << 8) / total);
+        return (scale == 0) ? 0 : static_cast<uint8_t>(scale - 1);
+    }
+
+    void Show(bool maintainBufferConsistency = true) override
+    {
+        // the running total makes the limit cheap to find every Show,
+        // so a new budget applies even when no pixel changed
+        this->_showScaled(maintainBufferConsistency, CalcLimitRatio(), _saved);
+    }
+
+    void SetPixelColor(uint16_t indexPixel, ColorObject color) override
+    {
+        if (indexPixel < this->PixelCount())
+        {
+            _totalTenthMilliAmpere -= _current(Base::GetPixelColor(indexPixel));
+            _totalTenthMilliAmpere += _current(color);
+            Base::SetPixelColor(indexPixel, color);
+        }
+    }
+
+    void SetPixels(uint16_t first, const ColorObject* pColors, uint16_t count)
+    {
+        count = this->_clampSpan(first, count);
+        if (count != 0)
+        {
+            _totalTenthMilliAmpere -= _sum(first, first + count - 1);
+            Base::SetPixels(first, pColors, count);
+            _totalTenthMilliAmpere += _sum(first, first + count - 1);
+        }
+    }
+
+    template <typename T_SOURCE_FEATURE> void SetPixelsRaw(uint16_t first, const uint8_t* pSource, uint16_t count)
+    {
+        count = this->_clampSpan(first, count);
+        if (count != 0)
+        {
+            _totalTenthMilliAmpere -= _sum(first, first + count - 1);
+            Base::template SetPixelsRaw<T_SOURCE_FEATURE>(first, pSource, count);
+            _totalTenthMilliAmpere += _sum(first, first + count - 1);
+        }
+    }
+
+    void ClearTo(ColorObject color)
+    {
+        Base::ClearTo(color);
+        _totalTenthMilliAmpere = _current(color) * this->PixelCount();
+        _stale = false;
+    }
+
+    void ClearTo(ColorObject color, uint16_t first, uint16_t last)
+    {
+        if (first < this->PixelCount() &&
+            last < this->PixelCount() &&
+            first <= last)
+        {
+            _totalTenthMilliAmpere -= _sum(first, last);
+            _totalTenthMilliAmpere += _current(color) * (last - first + 1);
+        }
+        Base::ClearTo(color, first, last);
+    }
+
+    void ShiftLeft(uint16_t shiftCount)
+    {
+        ShiftLeft(shiftCount, 0, this->PixelCount() - 1);
+    }
+
+    void ShiftLeft(uint16_t shiftCount, uint16_t first, uint16_t last)
+    {
+        if (_isValidShift(shiftCount, first, last))
+        {
+            // the front is shifted out, the back stays as it was
+            _totalTenthMilliAmpere += _sum(last - shiftCount + 1, last);
+            _totalTenthMilliAmpere -= _sum(first, first + shiftCount - 1);
+        }
+        Base::ShiftLeft(shiftCount, first, last);
+    }
+
+    void ShiftRight(uint16_t shiftCount)
+    {
+        ShiftRight(shiftCount, 0, this->PixelCount() - 1);
+    }
+
+    void ShiftRight(uint16_t shiftCount, uint16_t first, uint16_t last)
+    {
+        if (_isValidShift(shiftCount, first, last))
+        {
+            // the back is shifted out, the front stays as it was
+            _totalTenthMilliAmpere += _sum(first, first + shiftCount - 1);
+            _totalTenthMilliAmpere -= _sum(last - shiftCount + 1, last);
+        }
+        Base::ShiftRight(shiftCount, first, last);
+    }
+
+private:
+    SettingsObject _settings;
+    uint32_t _totalTenthMilliAmpere = 0;
+    uint32_t _budgetTenthMilliAmpere = 0;
+    bool _stale = false;
+    uint8_t* _saved = nullptr; // the pixels while a dimmed frame is sent
+
+    uint32_t _current(const ColorObject& color) const
+    {
+        return color.CalcTotalTenthMilliAmpere(_settings);
+    }
+
+    uint32_t _sum(uint16_t first, uint16_t last) const
+    {
+        uint32_t sum = 0;
+
+        for (uint16_t index = first; index <= last; index++)
+        {
+            sum += _current(Base::GetPixelColor(index));
+        }
+        return sum;
+    }
+
+    uint32_t _total()
+    {
+        if (_stale)
+        {
+            _totalTenthMilliAmpere = (this->PixelCount() != 0) ? _sum(0, this->PixelCount() - 1) : 0;
+            _stale = false;
+        }
+        return _totalTenthMilliAmpere;
+    }
+
+    // the same checks the shifts of NeoPixelBus make; a zero shift changes
+    // nothing and would have _sum wrap from first to first - 1
+    bool _isValidShift(uint16_t shiftCount, uint16_t first, uint16_t last) const
+    {
+        return (shiftCount != 0 &&
+            first < this->PixelCount() &&
+            last < this->PixelCount() &&
+            first < last &&
+            (last - first) >= shiftCount);
+    }
+};
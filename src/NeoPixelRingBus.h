@@ -0,0 +1,252 @@
+/*-------------------------------------------------------------------------
+NeoPixelBus library wrapper template class that rotates the whole strip by
+moving where it starts rather than moving the pixels
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "NeoPixelBus.h"
+
+// NeoPixelRingBus treats the strip as a ring: RotateLeft and RotateRight of
+// the whole strip only move the index of the pixel stored first, so they
+// cost the same for any length.  Methods that implement SetOutputRotation
+// (the ESP32 I2S and RMT, and the ESP8266 DMA methods) send the pixels
+// from there with the front wrapped to the end; for all others the pixels
+// are put back in order at every Show that follows a rotate, which costs
+// the same as rotating them.  Anything that works on the stored pixels
+// directly (Pixels(), Blt, Render, ranged rotates and shifts) puts them
+// back in order first
+template<typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelRingBus :
+    public NeoPixelBus<T_COLOR_FEATURE, T_METHOD>
+{
+public:
+    typedef NeoPixelBus<T_COLOR_FEATURE, T_METHOD> Base;
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    NeoPixelRingBus(uint16_t countPixels, uint8_t pin) :
+        Base(countPixels, pin)
+    {
+    }
+
+    NeoPixelRingBus(uint16_t countPixels, uint8_t pinClock, uint8_t pinData) :
+        Base(countPixels, pinClock, pinData)
+    {
+    }
+
+    NeoPixelRingBus(uint16_t countPixels) :
+        Base(countPixels)
+    {
+    }
+
+    operator NeoBufferContext<T_COLOR_FEATURE>()
+    {
+        _unrotate();
+        return Base::operator NeoBufferContext<T_COLOR_FEATURE>();
+    }
+
+    uint8_t* Pixels()
+    {
+        _unrotate();
+        return Base::Pixels();
+    }
+
+    void Show(bool maintainBufferConsistency = true) override
+    {
+        if (_rotation != _rotationSent)
+        {
+            // every pixel moved on the wire
+            this->Dirty();
+        }
+
+        if (!Base::_methodSetOutputRotation(this->_method, _rotation * T_COLOR_FEATURE::PixelSize, 0))
+        {
+            _unrotate();
+        }
+        _rotationSent = _rotation;
+
+        Base::Show(maintainBufferConsistency);
+    }
+
+    void SetPixelColor(uint16_t indexPixel, ColorObject color) override
+    {
+        if (indexPixel < this->PixelCount())
+        {
+            Base::SetPixelColor(_stored(indexPixel), color);
+        }
+    }
+
+    ColorObject GetPixelColor(uint16_t indexPixel) const override
+    {
+        if (indexPixel < this->PixelCount())
+        {
+            return Base::GetPixelColor(_stored(indexPixel));
+        }
+        return 0;
+    }
+
+    void SetPixels(uint16_t first, const ColorObject* pColors, uint16_t count)
+    {
+        count = this->_clampSpan(first, count);
+        if (count != 0)
+        {
+            uint16_t storedFirst = _stored(first);
+            uint16_t countBack = _countToEnd(storedFirst, count);
+
+            // a span that wraps around the end of the stored pixels
+            // continues from the front
+            Base::SetPixels(storedFirst, pColors, countBack);
+            Base::SetPixels(0, pColors + countBack, count - countBack);
+        }
+    }
+
+    template <typename T_SOURCE_FEATURE> void SetPixelsRaw(uint16_t first, const uint8_t* pSource, uint16_t count)
+    {
+        count = this->_clampSpan(first, count);
+        if (count != 0)
+        {
+            uint16_t storedFirst = _stored(first);
+            uint16_t countBack = _countToEnd(storedFirst, count);
+
+            Base::template SetPixelsRaw<T_SOURCE_FEATURE>(storedFirst, pSource, countBack);
+            Base::template SetPixelsRaw<T_SOURCE_FEATURE>(0,
+                T_SOURCE_FEATURE::getPixelAddress(pSource, countBack),
+                count - countBack);
+        }
+    }
+
+    void ClearTo(ColorObject color)
+    {
+        Base::ClearTo(color);
+    }
+
+    void ClearTo(ColorObject color, uint16_t first, uint16_t last)
+    {
+        if (first < this->PixelCount() &&
+            last < this->PixelCount() &&
+            first <= last)
+        {
+            uint16_t storedFirst = _stored(first);
+            uint16_t storedLast = _stored(last);
+
+            if (storedFirst <= storedLast)
+            {
+                Base::ClearTo(color, storedFirst, storedLast);
+            }
+            else
+            {
+                // the range wraps around the end of the stored pixels
+                Base::ClearTo(color, storedFirst, this->PixelCount() - 1);
+                Base::ClearTo(color, 0, storedLast);
+            }
+        }
+    }
+
+    void RotateLeft(uint16_t rotationCount)
+    {
+        if ((this->PixelCount() - 1) >= rotationCount && rotationCount != 0)
+        {
+            _rotation = _stored(rotationCount);
+            this->Dirty();
+        }
+    }
+
+    void RotateLeft(uint16_t rotationCount, uint16_t first, uint16_t last)
+    {
+        _unrotate();
+        Base::RotateLeft(rotationCount, first, last);
+    }
+
+    void RotateRight(uint16_t rotationCount)
+    {
+        if ((this->PixelCount() - 1) >= rotationCount && rotationCount != 0)
+        {
+            _rotation = _stored(this->PixelCount() - rotationCount);
+            this->Dirty();
+        }
+    }
+
+    void RotateRight(uint16_t rotationCount, uint16_t first, uint16_t last)
+    {
+        _unrotate();
+        Base::RotateRight(rotationCount, first, last);
+    }
+
+    void ShiftLeft(uint16_t shiftCount)
+    {
+        _unrotate();
+        Base::ShiftLeft(shiftCount);
+    }
+
+    void ShiftLeft(uint16_t shiftCount, uint16_t first, uint16_t last)
+    {
+        _unrotate();
+        Base::ShiftLeft(shiftCount, first, last);
+    }
+
+    void ShiftRight(uint16_t shiftCount)
+    {
+        _unrotate();
+        Base::ShiftRight(shiftCount);
+    }
+
+    void ShiftRight(uint16_t shiftCount, uint16_t first, uint16_t last)
+    {
+        _unrotate();
+        Base::ShiftRight(shiftCount, first, last);
+    }
+
+    // the index of the pixel stored first
+    uint16_t Rotation() const
+    {
+        return _rotation;
+    }
+
+protected:
+    uint16_t _rotation = 0;
+    uint16_t _rotationSent = 0;
+
+    uint16_t _stored(uint16_t indexPixel) const
+    {
+        uint32_t index = static_cast<uint32_t>(indexPixel) + _rotation;
+        return static_cast<uint16_t>((index < this->PixelCount()) ? index : index - this->PixelCount());
+    }
+
+    // how much of a span from a stored index fits before the end
+    uint16_t _countToEnd(uint16_t storedFirst, uint16_t count) const
+    {
+        uint16_t countToEnd = this->PixelCount() - storedFirst;
+        return (count < countToEnd) ? count : countToEnd;
+    }
+
+    // moves the pixels back in order
+    void _unrotate()
+    {
+        if (_rotation != 0)
+        {
+            this->_rotateLeft(_rotation, 0, this->PixelCount() - 1);
+            _rotation = 0;
+        }
+    }
+};
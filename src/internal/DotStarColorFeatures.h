@@ -42,38 +42,31 @@ public:
 
     static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            *pPixelDest++ = pPixelSrc[0];
-            *pPixelDest++ = pPixelSrc[1];
-            *pPixelDest++ = pPixelSrc[2];
-            *pPixelDest++ = pPixelSrc[3];
-        }
+        NeoElementsCopy<PixelSize>::replicatePixel(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            *pPixelDest++ = *pPixelSrc++;
-            *pPixelDest++ = *pPixelSrc++;
-            *pPixelDest++ = *pPixelSrc++;
-            *pPixelDest++ = *pPixelSrc++;
-        }
+        NeoElementsCopy<PixelSize>::movePixelsInc(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pDestBack = pPixelDest + (count * PixelSize);
-        const uint8_t* pSrcBack = pPixelSrc + (count * PixelSize);
-        while (pDestBack > pPixelDest)
+        NeoElementsCopy<PixelSize>::movePixelsDec(pPixelDest, pPixelSrc, count);
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsCopy<PixelSize>::rotatePixelsLeft(pPixels, count, rotationCount);
+    }
+
+    static void movePixelsInc_P(uint8_t* pPixelDest, PGM_VOID_P pPixelSrc, uint16_t count)
+    {
+        uint8_t* pEnd = pPixelDest + (count * PixelSize);
+        const uint8_t* pSrc = static_cast<const uint8_t*>(pPixelSrc);
+        while (pPixelDest < pEnd)
         {
-            *--pDestBack = *--pSrcBack;
-            *--pDestBack = *--pSrcBack;
-            *--pDestBack = *--pSrcBack;
-            *--pDestBack = *--pSrcBack;
+            *pPixelDest++ = pgm_read_byte(pSrc++);
         }
     }
 
@@ -96,38 +89,31 @@ public:
 
     static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            *pPixelDest++ = pPixelSrc[0];
-            *pPixelDest++ = pPixelSrc[1];
-            *pPixelDest++ = pPixelSrc[2];
-            *pPixelDest++ = pPixelSrc[3];
-        }
+        NeoElementsCopy<PixelSize>::replicatePixel(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            *pPixelDest++ = *pPixelSrc++;
-            *pPixelDest++ = *pPixelSrc++;
-            *pPixelDest++ = *pPixelSrc++;
-            *pPixelDest++ = *pPixelSrc++;
-        }
+        NeoElementsCopy<PixelSize>::movePixelsInc(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pDestBack = pPixelDest + (count * PixelSize);
-        const uint8_t* pSrcBack = pPixelSrc + (count * PixelSize);
-        while (pDestBack > pPixelDest)
+        NeoElementsCopy<PixelSize>::movePixelsDec(pPixelDest, pPixelSrc, count);
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsCopy<PixelSize>::rotatePixelsLeft(pPixels, count, rotationCount);
+    }
+
+    static void movePixelsInc_P(uint8_t* pPixelDest, PGM_VOID_P pPixelSrc, uint16_t count)
+    {
+        uint8_t* pEnd = pPixelDest + (count * PixelSize);
+        const uint8_t* pSrc = static_cast<const uint8_t*>(pPixelSrc);
+        while (pPixelDest < pEnd)
         {
-            *--pDestBack = *--pSrcBack;
-            *--pDestBack = *--pSrcBack;
-            *--pDestBack = *--pSrcBack;
-            *--pDestBack = *--pSrcBack;
+            *pPixelDest++ = pgm_read_byte(pSrc++);
         }
     }
 
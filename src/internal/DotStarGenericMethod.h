@@ -40,7 +40,8 @@ public:
     DotStarMethodBase(uint8_t pinClock, uint8_t pinData, uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
         _sizeData(pixelCount * elementSize + settingsSize),
         _sizeEndFrame((pixelCount + 15) / 16), // 16 = div 2 (bit for every two pixels) div 8 (bits to bytes)
-        _wire(pinClock, pinData)
+        _wire(pinClock, pinData),
+        _outputScale(NeoOutputScaleNone)
     {
         _data = static_cast<uint8_t*>(malloc(_sizeData));
         memset(_data, 0, _sizeData);
@@ -86,7 +87,14 @@ public:
         _wire.transmitBytes(startFrame, sizeof(startFrame));
         
         // data
-        _wire.transmitBytes(_data, _sizeData);
+        if (_outputScale == NeoOutputScaleNone)
+        {
+            _wire.transmitBytes(_data, _sizeData);
+        }
+        else
+        {
+            _transmitScaled();
+        }
 
        // reset frame
         _wire.transmitBytes(resetFrame, sizeof(resetFrame));
@@ -112,12 +120,43 @@ public:
         return _sizeData;
     };
 
+    // the colors are scaled as they are sent
+    bool SetOutputScale(uint16_t scale)
+    {
+        _outputScale = scale;
+        return true;
+    }
+
 private:
     const size_t   _sizeData;   // Size of '_data' buffer below
     const size_t   _sizeEndFrame;
 
     T_TWOWIRE _wire;
     uint8_t* _data;       // Holds LED color values
+    uint16_t _outputScale; // 8.8 scale applied to the colors as they are sent
+
+    void _transmitScaled()
+    {
+        uint8_t scaled[NeoOutputScaleChunkSize];
+
+        for (size_t offset = 0; offset < _sizeData; offset += sizeof(scaled))
+        {
+            size_t count = _sizeData - offset;
+            if (count > sizeof(scaled))
+            {
+                count = sizeof(scaled);
+            }
+
+            // every pixel is 4 bytes with the header/luminance byte first,
+            // it is sent unchanged; the chunk size keeps pixels aligned
+            for (size_t index = 0; index < count; index++)
+            {
+                uint8_t value = _data[offset + index];
+                scaled[index] = (index % 4 == 0) ? value : NeoScaleByte(value, _outputScale);
+            }
+            _wire.transmitBytes(scaled, count);
+        }
+    }
 };
 
 typedef DotStarMethodBase<TwoWireBitBangImple> DotStarMethod;
@@ -92,6 +92,16 @@ typedef struct {
         size_t dma_count;
         uint32_t dma_buf_len :12;
         uint32_t unused      :20;
+
+        // called once from the ISR when the last data item has been sent
+        void (*volatile write_done_callback)(void*);
+        void* write_done_context;
+
+        // the DMA reached a bad descriptor, the ISR fell behind
+        volatile uint32_t dscr_err_count;
+
+        // the kind of method that set the bus up
+        i2s_owner_t owner;
 } i2s_bus_t;
 
 static uint8_t i2s_silence_buf[I2S_DMA_SILENCE_LEN];
@@ -271,6 +281,64 @@ void i2sSetPins(uint8_t bus_num, int8_t out, bool invert) {
 
 }
 
+// in parallel (LCD) mode every bit of the sample drives its own pin,
+// 8 bit samples are output on DATA_OUT8 to DATA_OUT15
+void i2sSetParallelPin(uint8_t bus_num, int8_t out, uint8_t lane, uint8_t bits_per_sample, bool invert) {
+    if (bus_num >= I2S_NUM_MAX || out < 0 || lane >= bits_per_sample) {
+        return;
+    }
+
+    int i2sSignal;
+#if !defined(CONFIG_IDF_TARGET_ESP32S2)
+//    (I2S_NUM_MAX == 2)
+    if (bus_num == 1) {
+        i2sSignal = I2S1O_DATA_OUT0_IDX;
+    }
+    else
+#endif
+    {
+        i2sSignal = I2S0O_DATA_OUT0_IDX;
+    }
+
+    if (bits_per_sample == 8) {
+        i2sSignal += 8;
+    }
+    i2sSignal += lane;
+
+    pinMode(out, OUTPUT);
+    gpio_matrix_out(out, i2sSignal, invert, false);
+}
+
+// the serial and the 8 and 16 lane parallel methods set the bus up
+// differently, so only one kind may use it; as the bus is never torn
+// down it keeps its owner
+bool i2sClaim(uint8_t bus_num, i2s_owner_t owner) {
+    if (bus_num >= I2S_NUM_MAX) {
+        return false;
+    }
+    if (I2S[bus_num].owner != I2S_OWNER_NONE && I2S[bus_num].owner != owner) {
+        return false;
+    }
+    I2S[bus_num].owner = owner;
+    return true;
+}
+
+void i2sSetWriteDoneCallback(uint8_t bus_num, void (*callback)(void*), void* context) {
+    if (bus_num >= I2S_NUM_MAX) {
+        return;
+    }
+    I2S[bus_num].write_done_callback = NULL;
+    I2S[bus_num].write_done_context = context;
+    I2S[bus_num].write_done_callback = callback;
+}
+
+uint32_t i2sGetDescriptorErrorCount(uint8_t bus_num) {
+    if (bus_num >= I2S_NUM_MAX) {
+        return 0;
+    }
+    return I2S[bus_num].dscr_err_count;
+}
+
 bool i2sWriteDone(uint8_t bus_num) {
     if (bus_num >= I2S_NUM_MAX) {
         return false;
@@ -278,7 +346,7 @@ bool i2sWriteDone(uint8_t bus_num) {
     return (I2S[bus_num].dma_items[I2S[bus_num].dma_count - 1].data == I2S[bus_num].silence_buf);
 }
 
-void i2sInit(uint8_t bus_num, uint32_t bits_per_sample, uint32_t sample_rate, i2s_tx_chan_mod_t chan_mod, i2s_tx_fifo_mod_t fifo_mod, size_t dma_count, size_t dma_len) {
+void i2sInit(uint8_t bus_num, bool parallel_mode, uint32_t bits_per_sample, uint32_t sample_rate, i2s_tx_chan_mod_t chan_mod, i2s_tx_fifo_mod_t fifo_mod, size_t dma_count, size_t dma_len) {
     if (bus_num >= I2S_NUM_MAX) {
         return;
     }
@@ -350,21 +418,29 @@ void i2sInit(uint8_t bus_num, uint32_t bits_per_sample, uint32_t sample_rate, i2
 
     typeof(i2s->conf) conf;
     conf.val = 0;
-    conf.tx_msb_shift = (bits_per_sample != 8);// 0:DAC/PCM, 1:I2S
-    conf.tx_right_first = (bits_per_sample == 8);
+    conf.tx_msb_shift = (bits_per_sample != 8 && !parallel_mode);// 0:DAC/PCM/LCD, 1:I2S
+    conf.tx_right_first = (bits_per_sample == 8 && !parallel_mode);
     i2s->conf.val = conf.val;
 
     typeof(i2s->conf2) conf2;
     conf2.val = 0;
-    conf2.lcd_en = (bits_per_sample == 8);
+    conf2.lcd_en = (bits_per_sample == 8 || parallel_mode);
     i2s->conf2.val = conf2.val;
 
+    if (parallel_mode) {
+        i2s->conf1.tx_pcm_bypass = 1;
+    }
+
     i2s->fifo_conf.tx_fifo_mod_force_en = 1;
 
     i2s->pdm_conf.rx_pdm_en = 0;
     i2s->pdm_conf.tx_pdm_en = 0;
 
-    i2sSetSampleRate(bus_num, sample_rate, bits_per_sample);
+    if (parallel_mode) {
+        i2sSetParallelRate(bus_num, sample_rate, bits_per_sample);
+    } else {
+        i2sSetSampleRate(bus_num, sample_rate, bits_per_sample);
+    }
 
     //  enable intr in cpu // 
     int i2sIntSource;
@@ -443,6 +519,33 @@ esp_err_t i2sSetSampleRate(uint8_t bus_num, uint32_t rate, uint8_t bits) {
     return ESP_OK;
 }
 
+// in parallel (LCD) mode one sample (word) is sent per bit clock and the
+// bit clock is half of the divided base clock, so the rate is given in words
+esp_err_t i2sSetParallelRate(uint8_t bus_num, uint32_t word_rate, uint8_t bits) {
+    if (bus_num >= I2S_NUM_MAX) {
+        return ESP_FAIL;
+    }
+
+    if (I2S[bus_num].rate == word_rate) {
+        return ESP_OK;
+    }
+
+    double denom = (double)1 / 63;
+    double clkmdiv = (double)I2S_BASE_CLK / 2 / word_rate;
+    if (clkmdiv > 256) {
+        log_e("rate is too low");
+        return ESP_FAIL;
+    }
+    I2S[bus_num].rate = word_rate;
+
+    int clkmInteger = clkmdiv;
+    int clkmDecimals = ((clkmdiv - clkmInteger) / denom);
+
+    i2sSetClock(bus_num, clkmInteger, clkmDecimals, 63, 1, bits);
+
+    return ESP_OK;
+}
+
 void IRAM_ATTR i2sDmaISR(void* arg)
 {
     i2s_dma_item_t* dummy = NULL;
@@ -451,14 +554,24 @@ void IRAM_ATTR i2sDmaISR(void* arg)
 
     if (dev->bus->int_st.out_eof) {
         i2s_dma_item_t* item = (i2s_dma_item_t*)(dev->bus->out_eof_des_addr);
+        // the last item going from data to silence ends the write
+        bool write_done = (item == &dev->dma_items[dev->dma_count - 1] && item->data != dev->silence_buf);
         item->data = dev->silence_buf;
         item->blocksize = dev->silence_len;
         item->datalen = dev->silence_len;
+        if (write_done && dev->write_done_callback) {
+            void (*callback)(void*) = dev->write_done_callback;
+            dev->write_done_callback = NULL;
+            callback(dev->write_done_context);
+        }
         if (xQueueIsQueueFullFromISR(dev->tx_queue) == pdTRUE) {
             xQueueReceiveFromISR(dev->tx_queue, &dummy, &hpTaskAwoken);
         }
         xQueueSendFromISR(dev->tx_queue, (void*)&item, &hpTaskAwoken);
     }
+    if (dev->bus->int_st.out_dscr_err) {
+        dev->dscr_err_count++;
+    }
     dev->bus->int_clr.val = dev->bus->int_st.val;
     if (hpTaskAwoken == pdTRUE) {
         portYIELD_FROM_ISR();
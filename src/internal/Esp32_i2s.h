@@ -18,18 +18,27 @@ typedef enum {
     I2S_FIFO_16BIT_DUAL, I2S_FIFO_16BIT_SINGLE, I2S_FIFO_32BIT_DUAL, I2S_FIFO_32BIT_SINGLE
 } i2s_tx_fifo_mod_t;
 
-void i2sInit(uint8_t bus_num, uint32_t bits_per_sample, uint32_t sample_rate, i2s_tx_chan_mod_t chan_mod, i2s_tx_fifo_mod_t fifo_mod, size_t dma_count, size_t dma_len);
+typedef enum {
+    I2S_OWNER_NONE, I2S_OWNER_SERIAL, I2S_OWNER_PARALLEL_8, I2S_OWNER_PARALLEL_16
+} i2s_owner_t;
+
+void i2sInit(uint8_t bus_num, bool parallel_mode, uint32_t bits_per_sample, uint32_t sample_rate, i2s_tx_chan_mod_t chan_mod, i2s_tx_fifo_mod_t fifo_mod, size_t dma_count, size_t dma_len);
 
 void i2sSetPins(uint8_t bus_num, int8_t out, bool invert);
+void i2sSetParallelPin(uint8_t bus_num, int8_t out, uint8_t lane, uint8_t bits_per_sample, bool invert);
 void i2sSetDac(uint8_t bus_num, bool right, bool left);
 
 esp_err_t i2sSetClock(uint8_t bus_num, uint8_t div_num, uint8_t div_b, uint8_t div_a, uint8_t bck, uint8_t bits_per_sample);
 esp_err_t i2sSetSampleRate(uint8_t bus_num, uint32_t sample_rate, uint8_t bits_per_sample);
+esp_err_t i2sSetParallelRate(uint8_t bus_num, uint32_t word_rate, uint8_t bits_per_sample);
 
 void i2sSetSilenceBuf(uint8_t bus_num, uint8_t* data, size_t len);
 
 size_t i2sWrite(uint8_t bus_num, uint8_t* data, size_t len, bool copy, bool free_when_sent);
 bool i2sWriteDone(uint8_t bus_num);
+bool i2sClaim(uint8_t bus_num, i2s_owner_t owner);
+void i2sSetWriteDoneCallback(uint8_t bus_num, void (*callback)(void*), void* context);
+uint32_t i2sGetDescriptorErrorCount(uint8_t bus_num);
 
 #ifdef __cplusplus
 }
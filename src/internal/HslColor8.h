@@ -0,0 +1,126 @@
+/*-------------------------------------------------------------------------
+HslColor8 provides an integer Hue, Saturation, Lightness color object that
+converts to RgbColor without floating point
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+#pragma once
+
+#include "NeoHueTable.h"
+
+// ------------------------------------------------------------------------
+// HslColor8 represents a color object that is represented by Hue,
+// Saturation, Lightness component values of 0 - 255.  The hue wraps, so
+// 256 would be a full turn of the wheel (HslColor H of 1.0) and a
+// lightness of 128 is the fully saturated color.  Converting to RgbColor
+// uses only a table lookup and integer math and is within 2 of the float
+// HslColor conversion
+// ------------------------------------------------------------------------
+struct HslColor8
+{
+    // ------------------------------------------------------------------------
+    // Construct a HslColor8 that will have its values set in latter operations
+    // ------------------------------------------------------------------------
+    constexpr HslColor8() = default;
+
+    // ------------------------------------------------------------------------
+    // Construct a HslColor8 using H, S, L values (0 - 255)
+    // ------------------------------------------------------------------------
+    constexpr HslColor8(uint8_t h, uint8_t s, uint8_t l) :
+        H{h}, S{s}, L{l}
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    // LinearBlend between two colors by the amount defined by progress variable
+    // without floating point; the hue goes around the wheel the way the
+    // T_NEOHUEBLEND policy picks, through its HueBlend16
+    // left - the color to start the blend at
+    // right - the color to end the blend at
+    // progress - (0 - 255) value where 0 will return left and 255 will return right
+    //     and a value between will blend the color weighted linearly between them
+    // ------------------------------------------------------------------------
+    template <typename T_NEOHUEBLEND> static HslColor8 LinearBlend(const HslColor8& left,
+        const HslColor8& right,
+        uint8_t progress)
+    {
+        uint16_t weight = static_cast<uint16_t>(progress) + (progress >> 7);
+        uint16_t hue = T_NEOHUEBLEND::HueBlend16(static_cast<uint16_t>(left.H << 8),
+            static_cast<uint16_t>(right.H << 8),
+            static_cast<uint16_t>(progress * 257));
+
+        // rounded to the nearest 8 bit hue, wrapping at the top
+        return HslColor8(static_cast<uint8_t>((hue + 128) >> 8),
+            _linearBlend(left.S, right.S, weight),
+            _linearBlend(left.L, right.L, weight));
+    }
+
+    // ------------------------------------------------------------------------
+    // ConvertToRgb converts count colors at once, like a rainbow span
+    // ------------------------------------------------------------------------
+    static void ConvertToRgb(RgbColor* pDest, const HslColor8* pSrc, uint16_t count)
+    {
+        for (uint16_t index = 0; index < count; index++)
+        {
+            pDest[index] = pSrc[index];
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Hue, Saturation, Lightness color members
+    // ------------------------------------------------------------------------
+    uint8_t H{};
+    uint8_t S{};
+    uint8_t L{};
+
+    // 8.8 weight where 256 is all right
+    static uint8_t _linearBlend(uint8_t left, uint8_t right, uint16_t weight)
+    {
+        return (static_cast<uint16_t>(left) * static_cast<uint16_t>(256 - weight) +
+            static_cast<uint16_t>(right) * weight) >> 8;
+    }
+
+    // the range the channels span around the lightness, 0 - 254
+    static uint8_t _chroma(uint8_t s, uint8_t l)
+    {
+        uint16_t nearest = (l < 128) ? l : 255 - l;
+        return (nearest * (static_cast<uint16_t>(s) + 1)) >> 7;
+    }
+
+    // a channel of the hue spread over the chroma from its lowest value
+    static uint8_t _channel(uint8_t hue, uint8_t low, uint8_t chroma)
+    {
+        return low + ((static_cast<uint16_t>(chroma) * (static_cast<uint16_t>(hue) + 1)) >> 8);
+    }
+};
+
+inline RgbColor::RgbColor(const HslColor8& color)
+{
+    const uint8_t* hue = NeoHueTable::Color(color.H);
+    uint8_t chroma = HslColor8::_chroma(color.S, color.L);
+    uint8_t low = color.L - (chroma >> 1);
+
+    R = HslColor8::_channel(hue[0], low, chroma);
+    G = HslColor8::_channel(hue[1], low, chroma);
+    B = HslColor8::_channel(hue[2], low, chroma);
+}
@@ -0,0 +1,184 @@
+/*-------------------------------------------------------------------------
+NeoBitTranspose provides the bit matrix transpose kernels used by the
+parallel (multiple lane) output methods.  They are platform neutral so
+they can be verified and benchmarked on a host.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+// All the kernels share one contract,
+//     static void Transpose(T_LANEWORD* pBits, const uint8_t* pLaneBytes)
+// where pLaneBytes holds one byte for each lane (8 for uint8_t lane words,
+// 16 for uint16_t) and pBits receives 8 lane words, pBits[0] holding the
+// most significant bit of every lane byte with lane 0 in bit 0
+
+// NeoBitTransposeReference moves one bit at a time; it is the reference
+// the other kernels are verified against
+template<typename T_LANEWORD> class NeoBitTransposeReference
+{
+public:
+    static const uint8_t LaneCount = sizeof(T_LANEWORD) * 8;
+
+    static void Transpose(T_LANEWORD* pBits, const uint8_t* pLaneBytes)
+    {
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            T_LANEWORD lanes = 0;
+            for (uint8_t lane = 0; lane < LaneCount; lane++)
+            {
+                lanes |= static_cast<T_LANEWORD>(((pLaneBytes[lane] >> (7 - bit)) & 0x01) << lane);
+            }
+            pBits[bit] = lanes;
+        }
+    }
+};
+
+// NeoBitTransposeSwar transposes 8x8 bits held in two 32 bit registers
+// with three delta swaps (2x2, 4x4 then 8x8 blocks), no table is needed
+template<typename T_LANEWORD> class NeoBitTransposeSwar;
+
+template<> class NeoBitTransposeSwar<uint8_t>
+{
+public:
+    static const uint8_t LaneCount = 8;
+
+    static void Transpose(uint8_t* pBits, const uint8_t* pLaneBytes)
+    {
+        // lane n is row n, bit n of the data byte is column n
+        uint32_t x = pLaneBytes[0] |
+            (static_cast<uint32_t>(pLaneBytes[1]) << 8) |
+            (static_cast<uint32_t>(pLaneBytes[2]) << 16) |
+            (static_cast<uint32_t>(pLaneBytes[3]) << 24);
+        uint32_t y = pLaneBytes[4] |
+            (static_cast<uint32_t>(pLaneBytes[5]) << 8) |
+            (static_cast<uint32_t>(pLaneBytes[6]) << 16) |
+            (static_cast<uint32_t>(pLaneBytes[7]) << 24);
+        uint32_t t;
+
+        t = (x ^ (x >> 7)) & 0x00aa00aa;
+        x = x ^ t ^ (t << 7);
+        t = (y ^ (y >> 7)) & 0x00aa00aa;
+        y = y ^ t ^ (t << 7);
+
+        t = (x ^ (x >> 14)) & 0x0000cccc;
+        x = x ^ t ^ (t << 14);
+        t = (y ^ (y >> 14)) & 0x0000cccc;
+        y = y ^ t ^ (t << 14);
+
+        t = (x & 0x0f0f0f0f) | ((y << 4) & 0xf0f0f0f0);
+        y = ((x >> 4) & 0x0f0f0f0f) | (y & 0xf0f0f0f0);
+        x = t;
+
+        // now data bit n is row n, the most significant first
+        pBits[0] = static_cast<uint8_t>(y >> 24);
+        pBits[1] = static_cast<uint8_t>(y >> 16);
+        pBits[2] = static_cast<uint8_t>(y >> 8);
+        pBits[3] = static_cast<uint8_t>(y);
+        pBits[4] = static_cast<uint8_t>(x >> 24);
+        pBits[5] = static_cast<uint8_t>(x >> 16);
+        pBits[6] = static_cast<uint8_t>(x >> 8);
+        pBits[7] = static_cast<uint8_t>(x);
+    }
+};
+
+template<> class NeoBitTransposeSwar<uint16_t>
+{
+public:
+    static const uint8_t LaneCount = 16;
+
+    static void Transpose(uint16_t* pBits, const uint8_t* pLaneBytes)
+    {
+        uint8_t bitsLow[8];
+        uint8_t bitsHigh[8];
+
+        NeoBitTransposeSwar<uint8_t>::Transpose(bitsLow, pLaneBytes);
+        NeoBitTransposeSwar<uint8_t>::Transpose(bitsHigh, pLaneBytes + 8);
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            pBits[bit] = bitsLow[bit] | (static_cast<uint16_t>(bitsHigh[bit]) << 8);
+        }
+    }
+};
+
+// NeoBitTransposeLut spreads every nibble of a lane byte across four
+// bytes with a 16 entry table and shifts it into place for its lane
+template<typename T_LANEWORD> class NeoBitTransposeLut;
+
+template<> class NeoBitTransposeLut<uint8_t>
+{
+public:
+    static const uint8_t LaneCount = 8;
+
+    static void Transpose(uint8_t* pBits, const uint8_t* pLaneBytes)
+    {
+        // byte n holds bit (3 - n) of the nibble
+        const uint32_t spread[16] =
+        {
+            0x00000000, 0x01000000, 0x00010000, 0x01010000,
+            0x00000100, 0x01000100, 0x00010100, 0x01010100,
+            0x00000001, 0x01000001, 0x00010001, 0x01010001,
+            0x00000101, 0x01000101, 0x00010101, 0x01010101,
+        };
+
+        uint32_t high = 0;
+        uint32_t low = 0;
+
+        for (uint8_t lane = 0; lane < LaneCount; lane++)
+        {
+            high |= spread[pLaneBytes[lane] >> 4] << lane;
+            low |= spread[pLaneBytes[lane] & 0x0f] << lane;
+        }
+
+        pBits[0] = static_cast<uint8_t>(high);
+        pBits[1] = static_cast<uint8_t>(high >> 8);
+        pBits[2] = static_cast<uint8_t>(high >> 16);
+        pBits[3] = static_cast<uint8_t>(high >> 24);
+        pBits[4] = static_cast<uint8_t>(low);
+        pBits[5] = static_cast<uint8_t>(low >> 8);
+        pBits[6] = static_cast<uint8_t>(low >> 16);
+        pBits[7] = static_cast<uint8_t>(low >> 24);
+    }
+};
+
+template<> class NeoBitTransposeLut<uint16_t>
+{
+public:
+    static const uint8_t LaneCount = 16;
+
+    static void Transpose(uint16_t* pBits, const uint8_t* pLaneBytes)
+    {
+        uint8_t bitsLow[8];
+        uint8_t bitsHigh[8];
+
+        NeoBitTransposeLut<uint8_t>::Transpose(bitsLow, pLaneBytes);
+        NeoBitTransposeLut<uint8_t>::Transpose(bitsHigh, pLaneBytes + 8);
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            pBits[bit] = bitsLow[bit] | (static_cast<uint16_t>(bitsHigh[bit]) << 8);
+        }
+    }
+};
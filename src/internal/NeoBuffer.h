@@ -75,6 +75,17 @@ public:
         _method.ClearTo(color);
     };
 
+    // only buffers held in RAM can be rotated
+    void RotateLeft(uint16_t rotationCount)
+    {
+        _method.RotateLeft(rotationCount);
+    };
+
+    void RotateRight(uint16_t rotationCount)
+    {
+        _method.RotateRight(rotationCount);
+    };
+
     void Blt(NeoBufferContext<typename T_BUFFER_METHOD::ColorFeature> destBuffer,
         uint16_t indexPixel)
     {
@@ -144,11 +155,11 @@ public:
 
         for (uint16_t indexPixel = 0; indexPixel < countPixels; indexPixel++)
         {
-            typename T_BUFFER_METHOD::ColorObject color;
-            
-            shader.Apply(indexPixel, (uint8_t*)(&color), _method.Pixels() + (indexPixel * _method.PixelSize()));
+            // both pixels are laid out as the feature stores them, as the
+            // shader works on their bytes
+            uint8_t* pDest = T_BUFFER_METHOD::ColorFeature::getPixelAddress(destBuffer.Pixels, indexPixel);
 
-            T_BUFFER_METHOD::ColorFeature::applyPixelColor(destBuffer.Pixels, indexPixel, color);
+            shader.Apply(indexPixel, pDest, _method.Pixels() + (indexPixel * _method.PixelSize()));
         }
     }
 
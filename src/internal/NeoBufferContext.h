@@ -42,7 +42,53 @@ template <typename T_COLOR_FEATURE> struct NeoBufferContext
         return SizePixels / T_COLOR_FEATURE::PixelSize;
     };
 
+    // blends count pixels of left and right into dest through LinearBlend8
+    // or LinearBlend16 of the color object, picked by the type of progress,
+    // a uint8_t (0 - 255) or uint16_t (0 - 65535); dest may be left or right
+    template <typename T_PROGRESS> static void BlendBuffers(NeoBufferContext<T_COLOR_FEATURE> dest,
+        NeoBufferContext<T_COLOR_FEATURE> left,
+        NeoBufferContext<T_COLOR_FEATURE> right,
+        uint16_t count,
+        T_PROGRESS progress)
+    {
+        uint16_t countMax = dest.PixelCount();
+
+        if (left.PixelCount() < countMax)
+        {
+            countMax = left.PixelCount();
+        }
+        if (right.PixelCount() < countMax)
+        {
+            countMax = right.PixelCount();
+        }
+        if (count > countMax)
+        {
+            count = countMax;
+        }
+
+        for (uint16_t indexPixel = 0; indexPixel < count; indexPixel++)
+        {
+            T_COLOR_FEATURE::applyPixelColor(dest.Pixels, indexPixel,
+                _linearBlend(
+                    T_COLOR_FEATURE::retrievePixelColor(left.Pixels, indexPixel),
+                    T_COLOR_FEATURE::retrievePixelColor(right.Pixels, indexPixel),
+                    progress));
+        }
+    }
+
     uint8_t* Pixels;
     const size_t SizePixels;
-    
+
+private:
+    typedef typename T_COLOR_FEATURE::ColorObject ColorObject;
+
+    static ColorObject _linearBlend(const ColorObject& left, const ColorObject& right, uint8_t progress)
+    {
+        return ColorObject::LinearBlend8(left, right, progress);
+    }
+
+    static ColorObject _linearBlend(const ColorObject& left, const ColorObject& right, uint16_t progress)
+    {
+        return ColorObject::LinearBlend16(left, right, progress);
+    }
 };
\ No newline at end of file
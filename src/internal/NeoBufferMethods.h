@@ -148,6 +148,23 @@ public:
         T_COLOR_FEATURE::replicatePixel(_pixels, temp, PixelCount());
     };
 
+    // the pixels are rotated in storage order, wrapping row to row
+    void RotateLeft(uint16_t rotationCount)
+    {
+        if (rotationCount < PixelCount())
+        {
+            T_COLOR_FEATURE::rotatePixelsLeft(_pixels, PixelCount(), rotationCount);
+        }
+    }
+
+    void RotateRight(uint16_t rotationCount)
+    {
+        if (rotationCount < PixelCount())
+        {
+            T_COLOR_FEATURE::rotatePixelsLeft(_pixels, PixelCount(), PixelCount() - rotationCount);
+        }
+    }
+
     void CopyPixels(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
         T_COLOR_FEATURE::movePixelsInc(pPixelDest, pPixelSrc, count);
@@ -0,0 +1,146 @@
+/*-------------------------------------------------------------------------
+NeoBusStats provides the frame timing policies for NeoPixelBus.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <Arduino.h>
+
+// the timings are of the last frame, in microseconds
+struct NeoBusStats
+{
+    uint32_t showCount;         // Shows that sent a frame
+    uint32_t skippedShowCount;  // Shows without a change to send
+    uint32_t waitMicros;        // waiting for the previous send to finish
+    uint32_t updateMicros;      // encoding and starting the send
+    uint32_t wireMicros;        // from the end of the update until found ready again
+    uint32_t framesPerSecond;   // frames sent during the last whole second
+    uint32_t underrunCount;     // as reported by the method, 0 if it doesn't
+};
+
+// NeoNoStats is the default; every call is empty and Now never reads the
+// clock, so the instrumentation compiles away
+class NeoNoStats
+{
+public:
+    static const bool Enabled = false;
+
+    uint32_t Now() const
+    {
+        return 0;
+    }
+
+    void OnSkippedShow()
+    {
+    }
+
+    void OnWait(uint32_t, uint32_t)
+    {
+    }
+
+    void OnUpdate(uint32_t, uint32_t, uint32_t)
+    {
+    }
+
+    void OnReady(uint32_t)
+    {
+    }
+
+    NeoBusStats Stats() const
+    {
+        return NeoBusStats();
+    }
+};
+
+// NeoFrameStats records the timings of every Show
+class NeoFrameStats
+{
+public:
+    static const bool Enabled = true;
+
+    NeoFrameStats() :
+        _stats(),
+        _sending(false),
+        _sendStart(0),
+        _secondStart(0),
+        _secondFrames(0)
+    {
+    }
+
+    uint32_t Now() const
+    {
+        return micros();
+    }
+
+    void OnSkippedShow()
+    {
+        _stats.skippedShowCount++;
+    }
+
+    void OnWait(uint32_t start, uint32_t end)
+    {
+        _stats.waitMicros = end - start;
+        OnReady(end);
+    }
+
+    void OnUpdate(uint32_t start, uint32_t end, uint32_t underrunCount)
+    {
+        _stats.showCount++;
+        _stats.updateMicros = end - start;
+        _stats.underrunCount = underrunCount;
+
+        _sending = true;
+        _sendStart = end;
+
+        _secondFrames++;
+        if (end - _secondStart >= 1000000)
+        {
+            _stats.framesPerSecond = _secondFrames;
+            _secondFrames = 0;
+            _secondStart = end;
+        }
+    }
+
+    void OnReady(uint32_t now)
+    {
+        if (_sending)
+        {
+            _stats.wireMicros = now - _sendStart;
+            _sending = false;
+        }
+    }
+
+    NeoBusStats Stats() const
+    {
+        return _stats;
+    }
+
+private:
+    NeoBusStats _stats;
+    bool _sending;
+    uint32_t _sendStart;
+    uint32_t _secondStart;
+    uint32_t _secondFrames;
+};
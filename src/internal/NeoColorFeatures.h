@@ -42,32 +42,31 @@ public:
 
     static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            for (uint8_t iElement = 0; iElement < PixelSize; iElement++)
-            {
-                *pPixelDest++ = pPixelSrc[iElement];
-            }
-        }
+        NeoElementsCopy<PixelSize>::replicatePixel(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            *pPixelDest++ = *pPixelSrc++;
-        }
+        NeoElementsCopy<PixelSize>::movePixelsInc(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pDestBack = pPixelDest + (count * PixelSize);
-        const uint8_t* pSrcBack = pPixelSrc + (count * PixelSize);
-        while (pDestBack > pPixelDest)
+        NeoElementsCopy<PixelSize>::movePixelsDec(pPixelDest, pPixelSrc, count);
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsCopy<PixelSize>::rotatePixelsLeft(pPixels, count, rotationCount);
+    }
+
+    static void movePixelsInc_P(uint8_t* pPixelDest, PGM_VOID_P pPixelSrc, uint16_t count)
+    {
+        uint8_t* pEnd = pPixelDest + (count * PixelSize);
+        const uint8_t* pSrc = static_cast<const uint8_t*>(pPixelSrc);
+        while (pPixelDest < pEnd)
         {
-            *--pDestBack = *--pSrcBack;
+            *pPixelDest++ = pgm_read_byte(pSrc++);
         }
     }
 
@@ -90,36 +89,32 @@ public:
 
     static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint32_t* pDest = (uint32_t*)pPixelDest;
-        const uint32_t* pSrc = (const uint32_t*)pPixelSrc;
-
-        uint32_t* pEnd = pDest + count;
-        while (pDest < pEnd)
-        {
-            *pDest++ = *pSrc;
-        }
+        NeoElementsCopy<PixelSize>::replicatePixel(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint32_t* pDest = (uint32_t*)pPixelDest;
-        const uint32_t* pSrc = (uint32_t*)pPixelSrc;
-        uint32_t* pEnd = pDest + count;
-        while (pDest < pEnd)
-        {
-            *pDest++ = *pSrc++;
-        }
+        NeoElementsCopy<PixelSize>::movePixelsInc(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        NeoElementsCopy<PixelSize>::movePixelsDec(pPixelDest, pPixelSrc, count);
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsCopy<PixelSize>::rotatePixelsLeft(pPixels, count, rotationCount);
+    }
+
+    static void movePixelsInc_P(uint8_t* pPixelDest, PGM_VOID_P pPixelSrc, uint16_t count)
     {
         uint32_t* pDest = (uint32_t*)pPixelDest;
-        const uint32_t* pSrc = (uint32_t*)pPixelSrc;
-        uint32_t* pDestBack = pDest + count;
-        const uint32_t* pSrcBack = pSrc + count;
-        while (pDestBack > pDest)
+        const uint32_t* pSrc = (const uint32_t*)pPixelSrc;
+        uint32_t* pEnd = pDest + count;
+        while (pDest < pEnd)
         {
-            *--pDestBack = *--pSrcBack;
+            *pDest++ = pgm_read_dword(pSrc++);
         }
     }
 
@@ -163,6 +163,26 @@ public:
         Dirty();
     };
 
+    void RotateLeft(uint16_t rotationCount)
+    {
+        if (rotationCount < PixelCount())
+        {
+            // the color objects are plain bytes, so they rotate as those
+            NeoElementsRotate::rotateLeft(reinterpret_cast<uint8_t*>(_pixels),
+                PixelsSize(),
+                rotationCount * PixelSize());
+            Dirty();
+        }
+    };
+
+    void RotateRight(uint16_t rotationCount)
+    {
+        if (rotationCount < PixelCount())
+        {
+            RotateLeft(PixelCount() - rotationCount);
+        }
+    };
+
     template <typename T_COLOR_FEATURE, typename T_SHADER> 
     void Render(NeoBufferContext<T_COLOR_FEATURE> destBuffer, T_SHADER& shader, uint16_t destIndexPixel = 0)
     {
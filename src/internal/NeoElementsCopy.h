@@ -0,0 +1,194 @@
+/*-------------------------------------------------------------------------
+NeoElementsCopy provides the pixel replicate, move and rotate routines
+shared by the element classes of the color features
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+// NeoElementsRotate rotates in place through a small fixed buffer, so a
+// rotate of any count is safe on a small stack.  Short sides are moved
+// with one memmove; otherwise the shorter side is swapped into place and
+// what is left is rotated the same way, so every byte moves about once
+class NeoElementsRotate
+{
+public:
+    static const size_t TempSize = 64;
+
+    static void rotateLeft(uint8_t* pBytes, size_t sizeBytes, size_t sizeFront)
+    {
+        uint8_t temp[TempSize];
+
+        while (sizeFront != 0 && sizeFront < sizeBytes)
+        {
+            size_t sizeBack = sizeBytes - sizeFront;
+
+            if (sizeFront <= TempSize)
+            {
+                memcpy(temp, pBytes, sizeFront);
+                memmove(pBytes, pBytes + sizeFront, sizeBack);
+                memcpy(pBytes + sizeBack, temp, sizeFront);
+                return;
+            }
+
+            if (sizeBack <= TempSize)
+            {
+                memcpy(temp, pBytes + sizeFront, sizeBack);
+                memmove(pBytes + sizeBack, pBytes, sizeFront);
+                memcpy(pBytes, temp, sizeBack);
+                return;
+            }
+
+            if (sizeFront <= sizeBack)
+            {
+                // A B1 B2 becomes B1 A B2, leaving A B2 to rotate by A
+                _swap(pBytes, pBytes + sizeFront, sizeFront, temp);
+                pBytes += sizeFront;
+                sizeBytes -= sizeFront;
+            }
+            else
+            {
+                // A1 A2 B becomes B A2 A1, leaving A2 A1 to rotate by A2
+                _swap(pBytes, pBytes + sizeFront, sizeBack, temp);
+                pBytes += sizeBack;
+                sizeBytes -= sizeBack;
+                sizeFront -= sizeBack;
+            }
+        }
+    }
+
+private:
+    static void _swap(uint8_t* pLeft, uint8_t* pRight, size_t size, uint8_t* temp)
+    {
+        // whole chunks are a fixed size the compiler copies inline
+        while (size >= TempSize)
+        {
+            memcpy(temp, pLeft, TempSize);
+            memcpy(pLeft, pRight, TempSize);
+            memcpy(pRight, temp, TempSize);
+
+            pLeft += TempSize;
+            pRight += TempSize;
+            size -= TempSize;
+        }
+
+        memcpy(temp, pLeft, size);
+        memcpy(pLeft, pRight, size);
+        memcpy(pRight, temp, size);
+    }
+};
+
+// NeoElementsCopy works on any pixel size through the platform memcpy and
+// memmove, which copy whole words whatever the alignment of the pixels
+template<size_t V_PIXELSIZE> class NeoElementsCopy
+{
+public:
+    // the first pixel is copied from pPixelSrc, then what has been written
+    // so far is doubled, so only log2(count) copies are made
+    static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        size_t sizeTotal = count * V_PIXELSIZE;
+
+        if (sizeTotal == 0)
+        {
+            return;
+        }
+
+        memcpy(pPixelDest, pPixelSrc, V_PIXELSIZE);
+
+        size_t sizeDone = V_PIXELSIZE;
+        while (sizeDone < sizeTotal)
+        {
+            size_t sizeCopy = sizeTotal - sizeDone;
+            if (sizeCopy > sizeDone)
+            {
+                sizeCopy = sizeDone;
+            }
+
+            memcpy(pPixelDest + sizeDone, pPixelDest, sizeCopy);
+            sizeDone += sizeCopy;
+        }
+    }
+
+    // the moves may overlap in either direction
+    static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        memmove(pPixelDest, pPixelSrc, count * V_PIXELSIZE);
+    }
+
+    static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        memmove(pPixelDest, pPixelSrc, count * V_PIXELSIZE);
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsRotate::rotateLeft(pPixels, count * V_PIXELSIZE, rotationCount * V_PIXELSIZE);
+    }
+};
+
+// a four byte pixel is one aligned word, so it is stored directly
+template<> class NeoElementsCopy<4>
+{
+public:
+    static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        uint32_t* pDest = (uint32_t*)pPixelDest;
+        const uint32_t* pSrc = (const uint32_t*)pPixelSrc;
+
+        uint32_t* pEnd = pDest + count;
+        while (pDest < pEnd)
+        {
+            *pDest++ = *pSrc;
+        }
+    }
+
+    static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        uint32_t* pDest = (uint32_t*)pPixelDest;
+        const uint32_t* pSrc = (uint32_t*)pPixelSrc;
+        uint32_t* pEnd = pDest + count;
+        while (pDest < pEnd)
+        {
+            *pDest++ = *pSrc++;
+        }
+    }
+
+    static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
+    {
+        uint32_t* pDest = (uint32_t*)pPixelDest;
+        const uint32_t* pSrc = (uint32_t*)pPixelSrc;
+        uint32_t* pDestBack = pDest + count;
+        const uint32_t* pSrcBack = pSrc + count;
+        while (pDestBack > pDest)
+        {
+            *--pDestBack = *--pSrcBack;
+        }
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsRotate::rotateLeft(pPixels, count * 4, rotationCount * 4);
+    }
+};
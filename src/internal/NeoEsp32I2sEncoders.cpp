@@ -0,0 +1,105 @@
+/*-------------------------------------------------------------------------
+NeoEsp32I2sEncoders provides the encoder classes that convert the pixel
+data stream into the I2S DMA bit stream used by NeoEsp32I2sMethodBase.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include "NeoPixelBus.h"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(NEOPIXELBUS_HOST)
+
+// the low nibble pattern is the first 16 bit half as the I2S
+// peripheral sends the 16 bit halves of the dual fifo swapped
+#if defined(ARDUINO_ARCH_ESP32)
+DRAM_ATTR
+#endif
+const uint32_t NeoEsp32I2sByteEncoder::_table[256] = {
+    0x88888888, 0x8888888e, 0x888888e8, 0x888888ee,
+    0x88888e88, 0x88888e8e, 0x88888ee8, 0x88888eee,
+    0x8888e888, 0x8888e88e, 0x8888e8e8, 0x8888e8ee,
+    0x8888ee88, 0x8888ee8e, 0x8888eee8, 0x8888eeee,
+    0x888e8888, 0x888e888e, 0x888e88e8, 0x888e88ee,
+    0x888e8e88, 0x888e8e8e, 0x888e8ee8, 0x888e8eee,
+    0x888ee888, 0x888ee88e, 0x888ee8e8, 0x888ee8ee,
+    0x888eee88, 0x888eee8e, 0x888eeee8, 0x888eeeee,
+    0x88e88888, 0x88e8888e, 0x88e888e8, 0x88e888ee,
+    0x88e88e88, 0x88e88e8e, 0x88e88ee8, 0x88e88eee,
+    0x88e8e888, 0x88e8e88e, 0x88e8e8e8, 0x88e8e8ee,
+    0x88e8ee88, 0x88e8ee8e, 0x88e8eee8, 0x88e8eeee,
+    0x88ee8888, 0x88ee888e, 0x88ee88e8, 0x88ee88ee,
+    0x88ee8e88, 0x88ee8e8e, 0x88ee8ee8, 0x88ee8eee,
+    0x88eee888, 0x88eee88e, 0x88eee8e8, 0x88eee8ee,
+    0x88eeee88, 0x88eeee8e, 0x88eeeee8, 0x88eeeeee,
+    0x8e888888, 0x8e88888e, 0x8e8888e8, 0x8e8888ee,
+    0x8e888e88, 0x8e888e8e, 0x8e888ee8, 0x8e888eee,
+    0x8e88e888, 0x8e88e88e, 0x8e88e8e8, 0x8e88e8ee,
+    0x8e88ee88, 0x8e88ee8e, 0x8e88eee8, 0x8e88eeee,
+    0x8e8e8888, 0x8e8e888e, 0x8e8e88e8, 0x8e8e88ee,
+    0x8e8e8e88, 0x8e8e8e8e, 0x8e8e8ee8, 0x8e8e8eee,
+    0x8e8ee888, 0x8e8ee88e, 0x8e8ee8e8, 0x8e8ee8ee,
+    0x8e8eee88, 0x8e8eee8e, 0x8e8eeee8, 0x8e8eeeee,
+    0x8ee88888, 0x8ee8888e, 0x8ee888e8, 0x8ee888ee,
+    0x8ee88e88, 0x8ee88e8e, 0x8ee88ee8, 0x8ee88eee,
+    0x8ee8e888, 0x8ee8e88e, 0x8ee8e8e8, 0x8ee8e8ee,
+    0x8ee8ee88, 0x8ee8ee8e, 0x8ee8eee8, 0x8ee8eeee,
+    0x8eee8888, 0x8eee888e, 0x8eee88e8, 0x8eee88ee,
+    0x8eee8e88, 0x8eee8e8e, 0x8eee8ee8, 0x8eee8eee,
+    0x8eeee888, 0x8eeee88e, 0x8eeee8e8, 0x8eeee8ee,
+    0x8eeeee88, 0x8eeeee8e, 0x8eeeeee8, 0x8eeeeeee,
+    0xe8888888, 0xe888888e, 0xe88888e8, 0xe88888ee,
+    0xe8888e88, 0xe8888e8e, 0xe8888ee8, 0xe8888eee,
+    0xe888e888, 0xe888e88e, 0xe888e8e8, 0xe888e8ee,
+    0xe888ee88, 0xe888ee8e, 0xe888eee8, 0xe888eeee,
+    0xe88e8888, 0xe88e888e, 0xe88e88e8, 0xe88e88ee,
+    0xe88e8e88, 0xe88e8e8e, 0xe88e8ee8, 0xe88e8eee,
+    0xe88ee888, 0xe88ee88e, 0xe88ee8e8, 0xe88ee8ee,
+    0xe88eee88, 0xe88eee8e, 0xe88eeee8, 0xe88eeeee,
+    0xe8e88888, 0xe8e8888e, 0xe8e888e8, 0xe8e888ee,
+    0xe8e88e88, 0xe8e88e8e, 0xe8e88ee8, 0xe8e88eee,
+    0xe8e8e888, 0xe8e8e88e, 0xe8e8e8e8, 0xe8e8e8ee,
+    0xe8e8ee88, 0xe8e8ee8e, 0xe8e8eee8, 0xe8e8eeee,
+    0xe8ee8888, 0xe8ee888e, 0xe8ee88e8, 0xe8ee88ee,
+    0xe8ee8e88, 0xe8ee8e8e, 0xe8ee8ee8, 0xe8ee8eee,
+    0xe8eee888, 0xe8eee88e, 0xe8eee8e8, 0xe8eee8ee,
+    0xe8eeee88, 0xe8eeee8e, 0xe8eeeee8, 0xe8eeeeee,
+    0xee888888, 0xee88888e, 0xee8888e8, 0xee8888ee,
+    0xee888e88, 0xee888e8e, 0xee888ee8, 0xee888eee,
+    0xee88e888, 0xee88e88e, 0xee88e8e8, 0xee88e8ee,
+    0xee88ee88, 0xee88ee8e, 0xee88eee8, 0xee88eeee,
+    0xee8e8888, 0xee8e888e, 0xee8e88e8, 0xee8e88ee,
+    0xee8e8e88, 0xee8e8e8e, 0xee8e8ee8, 0xee8e8eee,
+    0xee8ee888, 0xee8ee88e, 0xee8ee8e8, 0xee8ee8ee,
+    0xee8eee88, 0xee8eee8e, 0xee8eeee8, 0xee8eeeee,
+    0xeee88888, 0xeee8888e, 0xeee888e8, 0xeee888ee,
+    0xeee88e88, 0xeee88e8e, 0xeee88ee8, 0xeee88eee,
+    0xeee8e888, 0xeee8e88e, 0xeee8e8e8, 0xeee8e8ee,
+    0xeee8ee88, 0xeee8ee8e, 0xeee8eee8, 0xeee8eeee,
+    0xeeee8888, 0xeeee888e, 0xeeee88e8, 0xeeee88ee,
+    0xeeee8e88, 0xeeee8e8e, 0xeeee8ee8, 0xeeee8eee,
+    0xeeeee888, 0xeeeee88e, 0xeeeee8e8, 0xeeeee8ee,
+    0xeeeeee88, 0xeeeeee8e, 0xeeeeeee8, 0xeeeeeeee
+};
+
+#endif
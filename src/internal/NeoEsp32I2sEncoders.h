@@ -0,0 +1,177 @@
+/*-------------------------------------------------------------------------
+NeoEsp32I2sEncoders provides the encoder classes that convert the pixel
+data stream into the I2S DMA bit stream used by NeoEsp32I2sMethodBase.
+They are platform neutral so they can be benchmarked on a host.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "NeoBitTranspose.h"
+#include "NeoOutputScale.h"
+
+// every data bit is sent as 4 I2S bits (1000 = 0, 1110 = 1)
+// so every data byte becomes 4 DMA bytes
+const uint16_t c_dmaBytesPerPixelBytes = 4;
+
+// NeoEsp32I2sNibbleEncoder uses a 16 entry table and two 16 bit stores
+// per data byte; it uses the least memory
+class NeoEsp32I2sNibbleEncoder
+{
+public:
+    static void Encode(uint8_t* pDmaBuffer, const uint8_t* pData, size_t sizeData)
+    {
+        const uint16_t bitpatterns[16] =
+        {
+            0b1000100010001000, 0b1000100010001110, 0b1000100011101000, 0b1000100011101110,
+            0b1000111010001000, 0b1000111010001110, 0b1000111011101000, 0b1000111011101110,
+            0b1110100010001000, 0b1110100010001110, 0b1110100011101000, 0b1110100011101110,
+            0b1110111010001000, 0b1110111010001110, 0b1110111011101000, 0b1110111011101110,
+        };
+
+        uint16_t* pDma = reinterpret_cast<uint16_t*>(pDmaBuffer);
+        const uint8_t* pEnd = pData + sizeData;
+        for (const uint8_t* pPixel = pData; pPixel < pEnd; pPixel++)
+        {
+            *(pDma++) = bitpatterns[((*pPixel) & 0x0f)];
+            *(pDma++) = bitpatterns[((*pPixel) >> 4) & 0x0f];
+        }
+    }
+};
+
+// NeoEsp32I2sByteEncoder uses a 256 entry table (1k of memory) that holds
+// the complete 32 bit DMA word for every data byte, so encoding is one
+// lookup and one aligned 32 bit store per data byte.  Its output is
+// identical to NeoEsp32I2sNibbleEncoder
+class NeoEsp32I2sByteEncoder
+{
+public:
+    static void Encode(uint8_t* pDmaBuffer, const uint8_t* pData, size_t sizeData)
+    {
+        uint32_t* pDma = reinterpret_cast<uint32_t*>(pDmaBuffer);
+        const uint8_t* pEnd = pData + sizeData;
+        const uint8_t* pEnd4 = pData + (sizeData & ~static_cast<size_t>(3));
+
+        // four bytes per pass gives the compiler independent loads and stores
+        while (pData < pEnd4)
+        {
+            pDma[0] = _table[pData[0]];
+            pDma[1] = _table[pData[1]];
+            pDma[2] = _table[pData[2]];
+            pDma[3] = _table[pData[3]];
+            pDma += 4;
+            pData += 4;
+        }
+
+        while (pData < pEnd)
+        {
+            *(pDma++) = _table[*(pData++)];
+        }
+    }
+
+private:
+    static const uint32_t _table[256];
+};
+
+// NeoEsp32I2sParallelEncoder interleaves the data streams of up to 8
+// (T_LANEWORD uint8_t) or 16 (uint16_t) lanes into one DMA stream for the
+// I2S parallel (LCD) mode, where every bit of a lane word drives one pin.
+// Every data bit is sent as 4 lane words (all high, data, data, all low).
+// T_TRANSPOSE is one of the NeoBitTranspose kernels
+template<typename T_LANEWORD, typename T_TRANSPOSE = NeoBitTransposeSwar<T_LANEWORD>> class NeoEsp32I2sParallelEncoder
+{
+public:
+    static const uint8_t LaneCount = sizeof(T_LANEWORD) * 8;
+    // 4 lane words for each of the 8 bits of a data byte
+    static const size_t DmaBytesPerDataByte = 8 * 4 * sizeof(T_LANEWORD);
+
+    // ppLaneData and pLaneSizes hold LaneCount entries; lanes shorter
+    // than sizeData, or unused lanes with a size of 0, are sent as zeros
+    static void Encode(uint8_t* pDmaBuffer,
+        const uint8_t* const* ppLaneData,
+        const size_t* pLaneSizes,
+        size_t sizeData)
+    {
+        _encode<false>(pDmaBuffer, ppLaneData, pLaneSizes, nullptr, nullptr, sizeData);
+    }
+
+    // as above, with the bytes of every lane past its settings scaled by
+    // the 8.8 scale of the lane as they are encoded
+    static void Encode(uint8_t* pDmaBuffer,
+        const uint8_t* const* ppLaneData,
+        const size_t* pLaneSizes,
+        const uint16_t* pLaneScales,
+        const size_t* pLaneSettingsSizes,
+        size_t sizeData)
+    {
+        _encode<true>(pDmaBuffer, ppLaneData, pLaneSizes, pLaneScales, pLaneSettingsSizes, sizeData);
+    }
+
+private:
+    template<bool V_SCALED> static void _encode(uint8_t* pDmaBuffer,
+        const uint8_t* const* ppLaneData,
+        const size_t* pLaneSizes,
+        const uint16_t* pLaneScales,
+        const size_t* pLaneSettingsSizes,
+        size_t sizeData)
+    {
+        uint32_t* pDma = reinterpret_cast<uint32_t*>(pDmaBuffer);
+
+        for (size_t index = 0; index < sizeData; index++)
+        {
+            uint8_t laneBytes[LaneCount];
+            for (uint8_t lane = 0; lane < LaneCount; lane++)
+            {
+                uint8_t value = (index < pLaneSizes[lane]) ? ppLaneData[lane][index] : 0;
+                if (V_SCALED && index >= pLaneSettingsSizes[lane])
+                {
+                    value = NeoScaleByte(value, pLaneScales[lane]);
+                }
+                laneBytes[lane] = value;
+            }
+
+            T_LANEWORD bits[8];
+            T_TRANSPOSE::Transpose(bits, laneBytes);
+
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                _writeBit(pDma, bits[bit]);
+            }
+        }
+    }
+
+    // the I2S fifo sends the two 16 bit halves of every 32 bit word
+    // swapped, so the lane words are stored in the order the hardware
+    // expects them rather than the order they are sent
+    static void _writeBit(uint32_t*& pDma, uint8_t lanes)
+    {
+        *(pDma++) = lanes | 0x00ff0000 | (static_cast<uint32_t>(lanes) << 24);
+    }
+
+    static void _writeBit(uint32_t*& pDma, uint16_t lanes)
+    {
+        *(pDma++) = lanes | 0xffff0000;
+        *(pDma++) = static_cast<uint32_t>(lanes) << 16;
+    }
+};
@@ -31,8 +31,7 @@ License along with NeoPixel.  If not, see
 #include <esp_log.h>
 
 #include "Esp32_i2s.h"
-
-const uint16_t c_dmaBytesPerPixelBytes = 4;
+#include "NeoEsp32I2sEncoders.h"
 
 class NeoEsp32I2sSpeedWs2812x
 {
@@ -106,12 +105,18 @@ public:
     const static bool Inverted = true;
 };
 
-template<typename T_SPEED, typename T_BUS, typename T_INVERT> class NeoEsp32I2sMethodBase
+// T_ENCODER selects how the data stream is converted into the DMA buffer,
+// see NeoEsp32I2sEncoders.h; NeoEsp32I2sByteEncoder is faster but uses 1k more memory
+template<typename T_SPEED, typename T_BUS, typename T_INVERT, typename T_ENCODER = NeoEsp32I2sNibbleEncoder> class NeoEsp32I2sMethodBase
 {
 public:
     NeoEsp32I2sMethodBase(uint8_t pin, uint16_t pixelCount, size_t elementSize, size_t settingsSize)  :
         _sizeData(pixelCount * elementSize + settingsSize),
-        _pin(pin)
+        _sizeSettings(settingsSize),
+        _pin(pin),
+        _outputScale(NeoOutputScaleNone),
+        _outputRotation(0),
+        _claimed(false)
     {
         uint16_t dmaSettingsSize = c_dmaBytesPerPixelBytes * settingsSize;
         uint16_t dmaPixelSize = c_dmaBytesPerPixelBytes * elementSize;
@@ -153,26 +158,72 @@ public:
 
     void Initialize()
     {
+        _claimed = i2sClaim(T_BUS::I2sBusNumber, I2S_OWNER_SERIAL);
+        if (!_claimed)
+        {
+            ESP_LOGE("NEOPIXL", "I2S bus %u is used by a parallel I2S method", T_BUS::I2sBusNumber);
+            return;
+        }
+
         size_t dmaCount = (_i2sBufferSize + I2S_DMA_MAX_DATA_LEN - 1) / I2S_DMA_MAX_DATA_LEN;
-        i2sInit(T_BUS::I2sBusNumber, 16, T_SPEED::I2sSampleRate, I2S_CHAN_STEREO, I2S_FIFO_16BIT_DUAL, dmaCount, 0);
+        i2sInit(T_BUS::I2sBusNumber, false, 16, T_SPEED::I2sSampleRate, I2S_CHAN_STEREO, I2S_FIFO_16BIT_DUAL, dmaCount, 0);
         i2sSetPins(T_BUS::I2sBusNumber, _pin, T_INVERT::Inverted);
     }
 
-    void Update(bool)
+    void Update(bool maintainBufferConsistency)
+    {
+        Update(maintainBufferConsistency, 0, _sizeData);
+    }
+
+    // the DMA buffer keeps the encoding of the last update, so only the
+    // bytes from dirtyOffset for dirtySize need to be encoded again
+    void Update(bool, size_t dirtyOffset, size_t dirtySize)
     {
+        if (!_claimed)
+        {
+            return;
+        }
+
         // wait for not actively sending data
         while (!IsReadyToUpdate())
         {
             yield();
         }
 
-        FillBuffers();
+        FillBuffers(dirtyOffset, dirtySize);
 
         const auto written = i2sWrite(T_BUS::I2sBusNumber, _i2sBuffer, _i2sBufferSize, false, false);
         if (written != _i2sBufferSize)
             ESP_LOGW("NEOPIXL", "written != bufferSize %zd %u", written, _i2sBufferSize);
     }
 
+    // callback is called from the I2S ISR once the next write is sent
+    void SetCompleteCallback(NeoShowCompleteCallback callback, void* context)
+    {
+        i2sSetWriteDoneCallback(T_BUS::I2sBusNumber, callback, context);
+    }
+
+    // the pixels are scaled as they are encoded
+    bool SetOutputScale(uint16_t scale)
+    {
+        _outputScale = scale;
+        return true;
+    }
+
+    // the pixels are sent starting from the pixel rotation bytes in
+    // (a whole number of pixels), the ones before it wrap to the end
+    bool SetOutputRotation(size_t rotation)
+    {
+        _outputRotation = rotation;
+        return true;
+    }
+
+    // DMA descriptor errors, counted by the I2S ISR
+    uint32_t UnderrunCount() const
+    {
+        return i2sGetDescriptorErrorCount(T_BUS::I2sBusNumber);
+    }
+
     uint8_t* getData() const
     {
         return _data;
@@ -185,6 +236,7 @@ public:
 
 private:
     const size_t  _sizeData;    // Size of '_data' buffer 
+    const size_t  _sizeSettings; // settings in front of the pixels, never scaled
     const uint8_t _pin;            // output pin number
         
     uint8_t*  _data;        // Holds LED color values
@@ -192,23 +244,17 @@ private:
     uint32_t _i2sBufferSize; // total size of _i2sBuffer
     uint8_t* _i2sBuffer;  // holds the DMA buffer that is referenced by _i2sBufDesc
 
-    void FillBuffers()
+    uint16_t _outputScale; // 8.8 scale applied to the pixels as they are encoded
+    size_t _outputRotation; // bytes into the pixels that are sent first
+    bool _claimed; // the I2S bus was free for this method
+
+    void FillBuffers(size_t offset, size_t size)
     {
-        const uint16_t bitpatterns[16] =
-        {
-            0b1000100010001000, 0b1000100010001110, 0b1000100011101000, 0b1000100011101110,
-            0b1000111010001000, 0b1000111010001110, 0b1000111011101000, 0b1000111011101110,
-            0b1110100010001000, 0b1110100010001110, 0b1110100011101000, 0b1110100011101110,
-            0b1110111010001000, 0b1110111010001110, 0b1110111011101000, 0b1110111011101110,
-        };
-
-        uint16_t* pDma = reinterpret_cast<uint16_t*>(_i2sBuffer);
-        uint8_t* pEnd = _data + _sizeData;
-        for (uint8_t* pPixel = _data; pPixel < pEnd; pPixel++)
-        {
-            *(pDma++) = bitpatterns[((*pPixel) & 0x0f)];
-            *(pDma++) = bitpatterns[((*pPixel) >> 4) & 0x0f];
-        }
+        NeoEncodeRotated(_data, offset, size, _sizeData, _sizeSettings, _outputRotation, _outputScale,
+            [this](size_t offsetBytes, const uint8_t* pBytes, size_t countBytes)
+            {
+                T_ENCODER::Encode(_i2sBuffer + offsetBytes * c_dmaBytesPerPixelBytes, pBytes, countBytes);
+            });
     }
 };
 
@@ -0,0 +1,507 @@
+/*-------------------------------------------------------------------------
+NeoPixel library helper functions for Esp32 using the I2S peripheral in
+parallel (LCD) mode, driving 8 or 16 strips from one DMA stream.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+// the parallel mode of the Esp32S2 I2S peripheral differs and is not supported
+#if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32S2)
+
+#include <esp_log.h>
+
+#include "Esp32_i2s.h"
+#include "NeoEsp32I2sEncoders.h"
+#include "NeoEsp32I2sMethod.h" // speed, bus and invert classes
+
+// NeoEsp32I2sParallelMux is shared by all the NeoPixelBus instances
+// (lanes) on one I2S bus; it holds the single DMA buffer that they are
+// all encoded into and sends it once every started lane has been updated.
+// The I2S bus belongs to the first kind of method that starts on it, the
+// X8 and X16 muxes and the serial I2S methods can't share one
+template<typename T_BUS, typename T_LANEWORD> class NeoEsp32I2sParallelMux
+{
+public:
+    typedef NeoEsp32I2sParallelEncoder<T_LANEWORD> T_ENCODER;
+
+    static const uint8_t LaneCount = T_ENCODER::LaneCount;
+
+    static NeoEsp32I2sParallelMux& Instance()
+    {
+        return s_instance;
+    }
+
+    // reserves a lane for the data, returns the lane index, or LaneCount
+    // if all lanes are taken
+    uint8_t RegisterLane(const uint8_t* pData)
+    {
+        for (uint8_t lane = 0; lane < LaneCount; lane++)
+        {
+            if (!(_maskRegistered & (1 << lane)))
+            {
+                _laneData[lane] = pData;
+                _laneSizes[lane] = 0;
+                _laneSettingsSizes[lane] = 0;
+                _laneScales[lane] = NeoOutputScaleNone;
+                _maskRegistered |= (1 << lane);
+                return lane;
+            }
+        }
+
+        ESP_LOGE("NEOPIXL", "all %u lanes of I2S bus %u are in use", LaneCount, T_BUS::I2sBusNumber);
+        return LaneCount;
+    }
+
+    void UnregisterLane(uint8_t lane)
+    {
+        if (lane < LaneCount)
+        {
+            _laneData[lane] = nullptr;
+            _laneSizes[lane] = 0;
+            _laneScales[lane] = NeoOutputScaleNone;
+            _maskRegistered &= ~(1 << lane);
+            _maskStarted &= ~(1 << lane);
+            _maskUpdated &= ~(1 << lane);
+            SetLaneCompleteCallback(lane, nullptr, nullptr);
+
+            if (_maskRegistered == 0)
+            {
+                free(_dmaBuffer);
+                _dmaBuffer = nullptr;
+                _dmaBufferSize = 0;
+            }
+        }
+    }
+
+    // starts sending the lane with the others, sizing the DMA buffer for
+    // the longest lane; wordRate is the number of lane words per second.
+    // The DMA descriptors are made by the first send for the lanes started
+    // by then, so start every lane before the first Show.  Returns false,
+    // and drops the lane, if the bus is used by another kind of I2S method,
+    // the speed differs from the lanes already started, the lane is too
+    // long for the descriptors or a larger DMA buffer can't be allocated
+    bool StartLane(uint8_t lane, size_t sizeData, size_t sizeSettings, uint32_t wordRate, size_t resetSize)
+    {
+        if (lane >= LaneCount)
+        {
+            return false;
+        }
+
+        if (_wordRate == 0)
+        {
+            if (!i2sClaim(T_BUS::I2sBusNumber, (LaneCount == 8) ? I2S_OWNER_PARALLEL_8 : I2S_OWNER_PARALLEL_16))
+            {
+                ESP_LOGE("NEOPIXL", "I2S bus %u is used by another I2S method", T_BUS::I2sBusNumber);
+                UnregisterLane(lane);
+                return false;
+            }
+            _wordRate = wordRate;
+        }
+        else if (wordRate != _wordRate)
+        {
+            ESP_LOGE("NEOPIXL", "the lanes of I2S bus %u must all use the same speed", T_BUS::I2sBusNumber);
+            UnregisterLane(lane);
+            return false;
+        }
+
+        size_t sizeMax = (sizeData > _maxLaneSize()) ? sizeData : _maxLaneSize();
+        size_t dmaBufferSize = sizeMax * T_ENCODER::DmaBytesPerDataByte + resetSize;
+
+        // must have a 4 byte aligned buffer for i2s
+        uint32_t alignment = dmaBufferSize % 4;
+        if (alignment)
+        {
+            dmaBufferSize += 4 - alignment;
+        }
+
+        if (_initialized && _dmaCount(dmaBufferSize) > _dmaCount(_dmaBufferSize))
+        {
+            ESP_LOGE("NEOPIXL", "lane %u is longer than I2S bus %u was started for", lane, T_BUS::I2sBusNumber);
+            UnregisterLane(lane);
+            return false;
+        }
+
+        if (dmaBufferSize > _dmaBufferSize)
+        {
+            // allocated before the old one is freed, which the lanes
+            // already started keep when it fails
+            uint8_t* dmaBuffer = static_cast<uint8_t*>(malloc(dmaBufferSize));
+
+            if (dmaBuffer == nullptr)
+            {
+                ESP_LOGE("NEOPIXL", "no memory for the DMA buffer of I2S bus %u lane %u", T_BUS::I2sBusNumber, lane);
+                UnregisterLane(lane);
+                return false;
+            }
+            memset(dmaBuffer, 0x00, dmaBufferSize);
+
+            while (_dmaBuffer && !IsWriteDone())
+            {
+                yield();
+            }
+
+            free(_dmaBuffer);
+            _dmaBuffer = dmaBuffer;
+            _dmaBufferSize = dmaBufferSize;
+        }
+
+        _laneSizes[lane] = sizeData;
+        _laneSettingsSizes[lane] = sizeSettings;
+        _maskStarted |= (1 << lane);
+        return true;
+    }
+
+    // the pixels of the lane are scaled as the lanes are encoded
+    void SetLaneScale(uint8_t lane, uint16_t scale)
+    {
+        if (lane < LaneCount)
+        {
+            _laneScales[lane] = scale;
+        }
+    }
+
+    // callback is called from the I2S ISR once the next write is sent;
+    // the bus has one write done callback, called once, so it is set again
+    // for every lane callback and calls those of all lanes
+    void SetLaneCompleteCallback(uint8_t lane, NeoShowCompleteCallback callback, void* context)
+    {
+        if (lane < LaneCount)
+        {
+            _laneCallbacks[lane] = nullptr;
+            _laneContexts[lane] = context;
+            _laneCallbacks[lane] = callback;
+
+            if (callback != nullptr)
+            {
+                i2sSetWriteDoneCallback(T_BUS::I2sBusNumber, _writeDone, this);
+            }
+        }
+    }
+
+    void SetPin(uint8_t lane, uint8_t pin, bool invert)
+    {
+        if (lane < LaneCount)
+        {
+            i2sSetParallelPin(T_BUS::I2sBusNumber, pin, lane, LaneCount, invert);
+        }
+    }
+
+    bool IsWriteDone() const
+    {
+        return (!_initialized || i2sWriteDone(T_BUS::I2sBusNumber));
+    }
+
+    // true while the lane waits on the other lanes to be updated
+    bool IsLaneStaged(uint8_t lane) const
+    {
+        return (lane < LaneCount && (_maskUpdated & (1 << lane)));
+    }
+
+    // the stream is sent when every started lane has been updated, or when
+    // a lane is updated again, so lanes that don't change don't stall the
+    // others; they still hold the stream back until then
+    void UpdateLane(uint8_t lane)
+    {
+        if (lane >= LaneCount || !(_maskStarted & (1 << lane)) || _dmaBuffer == nullptr)
+        {
+            return;
+        }
+
+        uint32_t maskLane = (1 << lane);
+        if (!(_maskUpdated & maskLane))
+        {
+            _maskUpdated |= maskLane;
+            if (_maskUpdated != _maskStarted)
+            {
+                return;
+            }
+        }
+
+        // wait for not actively sending data
+        while (!IsWriteDone())
+        {
+            yield();
+        }
+
+        if (!_initialized)
+        {
+            i2sInit(T_BUS::I2sBusNumber, true, LaneCount, _wordRate, I2S_CHAN_RIGHT_TO_LEFT, I2S_FIFO_16BIT_SINGLE, _dmaCount(_dmaBufferSize), 0);
+            _initialized = true;
+        }
+
+        if (_isScaled())
+        {
+            T_ENCODER::Encode(_dmaBuffer, _laneData, _laneSizes, _laneScales, _laneSettingsSizes, _maxLaneSize());
+        }
+        else
+        {
+            T_ENCODER::Encode(_dmaBuffer, _laneData, _laneSizes, _maxLaneSize());
+        }
+        _maskUpdated = 0;
+
+        const auto written = i2sWrite(T_BUS::I2sBusNumber, _dmaBuffer, _dmaBufferSize, false, false);
+        if (written != _dmaBufferSize)
+            ESP_LOGW("NEOPIXL", "written != bufferSize %zd %u", written, _dmaBufferSize);
+    }
+
+private:
+    static NeoEsp32I2sParallelMux s_instance;
+
+    const uint8_t* _laneData[LaneCount];
+    size_t _laneSizes[LaneCount]; // 0 until the lane is started
+    size_t _laneSettingsSizes[LaneCount];
+    uint16_t _laneScales[LaneCount];
+    uint32_t _maskRegistered;
+    uint32_t _maskStarted;
+    uint32_t _maskUpdated;
+    uint32_t _wordRate; // of the first lane started, all lanes must match
+    bool _initialized;
+    volatile NeoShowCompleteCallback _laneCallbacks[LaneCount];
+    void* _laneContexts[LaneCount];
+
+    uint32_t _dmaBufferSize; // total size of _dmaBuffer
+    uint8_t* _dmaBuffer;  // holds the DMA buffer of all lanes
+
+    // the write done callback of the bus, from the I2S ISR
+    static void _writeDone(void* context)
+    {
+        NeoEsp32I2sParallelMux* self = static_cast<NeoEsp32I2sParallelMux*>(context);
+
+        for (uint8_t lane = 0; lane < LaneCount; lane++)
+        {
+            NeoShowCompleteCallback callback = self->_laneCallbacks[lane];
+
+            if (callback != nullptr)
+            {
+                self->_laneCallbacks[lane] = nullptr;
+                callback(self->_laneContexts[lane]);
+            }
+        }
+    }
+
+    static size_t _dmaCount(size_t dmaBufferSize)
+    {
+        return (dmaBufferSize + I2S_DMA_MAX_DATA_LEN - 1) / I2S_DMA_MAX_DATA_LEN;
+    }
+
+    bool _isScaled() const
+    {
+        for (uint8_t lane = 0; lane < LaneCount; lane++)
+        {
+            if (_laneScales[lane] != NeoOutputScaleNone)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t _maxLaneSize() const
+    {
+        size_t sizeMax = 0;
+        for (uint8_t lane = 0; lane < LaneCount; lane++)
+        {
+            if (_laneSizes[lane] > sizeMax)
+            {
+                sizeMax = _laneSizes[lane];
+            }
+        }
+        return sizeMax;
+    }
+};
+
+// zero initialized as a global
+template<typename T_BUS, typename T_LANEWORD>
+NeoEsp32I2sParallelMux<T_BUS, T_LANEWORD> NeoEsp32I2sParallelMux<T_BUS, T_LANEWORD>::s_instance;
+
+// every NeoPixelBus using this method is one lane of the parallel bus;
+// all of them must use the same speed and be started with Begin before
+// the first Show.  The lanes go out together once each has been updated,
+// and Show skips a bus that isn't dirty, so call Show on every lane every
+// frame and Dirty() on those that didn't change, or the frame of the
+// others is held back and goes out with the next one
+template<typename T_SPEED, typename T_BUS, typename T_INVERT, typename T_LANEWORD> class NeoEsp32I2sParallelMethodBase
+{
+public:
+    typedef NeoEsp32I2sParallelMux<T_BUS, T_LANEWORD> T_MUX;
+
+    // the lane is encoded when the last lane is updated
+    const static bool DefersPixelRead = true;
+
+    NeoEsp32I2sParallelMethodBase(uint8_t pin, uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
+        _sizeData(pixelCount * elementSize + settingsSize),
+        _sizeSettings(settingsSize),
+        _pin(pin)
+    {
+        _data = static_cast<uint8_t*>(malloc(_sizeData));
+        memset(_data, 0x00, _sizeData);
+
+        _lane = T_MUX::Instance().RegisterLane(_data);
+    }
+
+    ~NeoEsp32I2sParallelMethodBase()
+    {
+        while (!IsWriteDone())
+        {
+            yield();
+        }
+
+        T_MUX::Instance().UnregisterLane(_lane);
+
+        pinMode(_pin, INPUT);
+
+        free(_data);
+    }
+
+    // false while the lane waits on the other lanes, updating it
+    // again sends the stream without them
+    bool IsReadyToUpdate() const
+    {
+        return (!T_MUX::Instance().IsLaneStaged(_lane) && IsWriteDone());
+    }
+
+    bool IsWriteDone() const
+    {
+        return T_MUX::Instance().IsWriteDone();
+    }
+
+    void Initialize()
+    {
+        // four lane words per data bit, sent at the rate of the serial I2S bit clock
+        uint32_t wordRate = T_SPEED::I2sSampleRate * 32;
+        size_t resetSize = T_MUX::T_ENCODER::DmaBytesPerDataByte * T_SPEED::ResetTimeUs / T_SPEED::ByteSendTimeUs;
+
+        if (T_MUX::Instance().StartLane(_lane, _sizeData, _sizeSettings, wordRate, resetSize))
+        {
+            T_MUX::Instance().SetPin(_lane, _pin, T_INVERT::Inverted);
+        }
+        else
+        {
+            // the lane was dropped, it sends nothing
+            _lane = T_MUX::LaneCount;
+        }
+    }
+
+    void Update(bool)
+    {
+        T_MUX::Instance().UpdateLane(_lane);
+    }
+
+    // callback is called from the I2S ISR once the next write of the
+    // parallel bus is sent, each lane has its own
+    void SetCompleteCallback(NeoShowCompleteCallback callback, void* context)
+    {
+        T_MUX::Instance().SetLaneCompleteCallback(_lane, callback, context);
+    }
+
+    // the pixels are scaled as the lanes are encoded
+    bool SetOutputScale(uint16_t scale)
+    {
+        T_MUX::Instance().SetLaneScale(_lane, scale);
+        return true;
+    }
+
+    // DMA descriptor errors, counted by the I2S ISR
+    uint32_t UnderrunCount() const
+    {
+        return i2sGetDescriptorErrorCount(T_BUS::I2sBusNumber);
+    }
+
+    uint8_t* getData() const
+    {
+        return _data;
+    };
+
+    size_t getDataSize() const
+    {
+        return _sizeData;
+    }
+
+private:
+    const size_t  _sizeData;    // Size of '_data' buffer
+    const size_t  _sizeSettings; // settings in front of the pixels, never scaled
+    const uint8_t _pin;         // output pin number
+
+    uint8_t _lane;          // lane of the parallel bus, LaneCount if it has none
+    uint8_t* _data;         // Holds LED color values
+};
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s0X8Ws2812xMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s0X8Sk6812Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s0X8Tm1814Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s0X8800KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s0X8400KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s0X8Apa106Method;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s0X8Ws2812xInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s0X8Sk6812InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s0X8Tm1814InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s0X8800KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s0X8400KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s0X8Apa106InvertedMethod;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s0X16Ws2812xMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s0X16Sk6812Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s0X16Tm1814Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s0X16800KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s0X16400KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s0X16Apa106Method;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s0X16Ws2812xInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s0X16Sk6812InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusZero, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s0X16Tm1814InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s0X16800KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s0X16400KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusZero, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s0X16Apa106InvertedMethod;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s1X8Ws2812xMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s1X8Sk6812Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s1X8Tm1814Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s1X8800KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s1X8400KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s1X8Apa106Method;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s1X8Ws2812xInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s1X8Sk6812InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint8_t> NeoEsp32I2s1X8Tm1814InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s1X8800KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s1X8400KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint8_t> NeoEsp32I2s1X8Apa106InvertedMethod;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s1X16Ws2812xMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s1X16Sk6812Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s1X16Tm1814Method;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s1X16800KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s1X16400KbpsMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s1X16Apa106Method;
+
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedWs2812x, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s1X16Ws2812xInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedSk6812, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s1X16Sk6812InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedTm1814, NeoEsp32I2sBusOne, NeoEsp32I2sNotInverted, uint16_t> NeoEsp32I2s1X16Tm1814InvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed800Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s1X16800KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeed400Kbps, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s1X16400KbpsInvertedMethod;
+typedef NeoEsp32I2sParallelMethodBase<NeoEsp32I2sSpeedApa106, NeoEsp32I2sBusOne, NeoEsp32I2sInverted, uint16_t> NeoEsp32I2s1X16Apa106InvertedMethod;
+
+#endif
@@ -31,6 +31,161 @@ License along with NeoPixel.  If not, see
 
 #ifdef ARDUINO_ARCH_ESP32
 
+#if __has_include("soc/soc_caps.h")
+#include "soc/soc_caps.h"
+#endif
+
+#if defined(SOC_RMT_SUPPORT_TX_SYNCHRO) && SOC_RMT_SUPPORT_TX_SYNCHRO
+#define NEO_RMT_SUPPORT_TX_SYNCHRO 1
+#else
+#define NEO_RMT_SUPPORT_TX_SYNCHRO 0
+#endif
+
+uint8_t NeoEsp32RmtMemory::s_claimedBlocks = 0;
+
+bool NeoEsp32RmtMemory::Claim(rmt_channel_t channel, uint8_t blockCount)
+{
+    uint8_t mask = _mask(channel, blockCount);
+
+    if (s_claimedBlocks & mask)
+    {
+        return false;
+    }
+    s_claimedBlocks |= mask;
+    return true;
+}
+
+void NeoEsp32RmtMemory::Release(rmt_channel_t channel, uint8_t blockCount)
+{
+    s_claimedBlocks &= ~_mask(channel, blockCount);
+}
+
+bool NeoEsp32RmtShowComplete::s_registered = false;
+volatile NeoShowCompleteCallback NeoEsp32RmtShowComplete::s_callbacks[RMT_CHANNEL_MAX] = {};
+void* NeoEsp32RmtShowComplete::s_contexts[RMT_CHANNEL_MAX] = {};
+
+void NeoEsp32RmtShowComplete::Set(rmt_channel_t channel, NeoShowCompleteCallback callback, void* context)
+{
+    s_callbacks[channel] = nullptr;
+    s_contexts[channel] = context;
+    s_callbacks[channel] = callback;
+
+    if (!s_registered)
+    {
+        rmt_register_tx_end_callback(_txEnd, nullptr);
+        s_registered = true;
+    }
+}
+
+void IRAM_ATTR NeoEsp32RmtShowComplete::_txEnd(rmt_channel_t channel, void*)
+{
+    NeoShowCompleteCallback callback = s_callbacks[channel];
+
+    if (callback != nullptr)
+    {
+        s_callbacks[channel] = nullptr;
+        callback(s_contexts[channel]);
+    }
+}
+
+uint8_t NeoEsp32RmtSyncGroup::s_registered = 0;
+uint8_t NeoEsp32RmtSyncGroup::s_staged = 0;
+const uint8_t* NeoEsp32RmtSyncGroup::s_data[RMT_CHANNEL_MAX] = {};
+size_t NeoEsp32RmtSyncGroup::s_sizeData[RMT_CHANNEL_MAX] = {};
+
+void NeoEsp32RmtSyncGroup::Register(rmt_channel_t channel)
+{
+    s_registered |= (1 << channel);
+#if NEO_RMT_SUPPORT_TX_SYNCHRO
+    ESP_ERROR_CHECK(rmt_add_channel_to_group(channel));
+#endif
+}
+
+void NeoEsp32RmtSyncGroup::Unregister(rmt_channel_t channel)
+{
+    s_registered &= ~(1 << channel);
+    s_staged &= ~(1 << channel);
+    s_data[channel] = nullptr;
+    s_sizeData[channel] = 0;
+#if NEO_RMT_SUPPORT_TX_SYNCHRO
+    ESP_ERROR_CHECK_WITHOUT_ABORT(rmt_remove_channel_from_group(channel));
+#endif
+}
+
+bool NeoEsp32RmtSyncGroup::IsReadyToUpdate(rmt_channel_t channel)
+{
+    // a staged channel waits on the others, showing it again sends it
+    return (!(s_staged & (1 << channel)) && IsWriteDone(channel));
+}
+
+bool NeoEsp32RmtSyncGroup::IsWriteDone(rmt_channel_t)
+{
+    for (uint8_t channel = 0; channel < RMT_CHANNEL_MAX; channel++)
+    {
+        if ((s_registered & (1 << channel)) &&
+            ESP_OK != rmt_wait_tx_done(static_cast<rmt_channel_t>(channel), 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t NeoEsp32RmtSyncGroup::WaitTxDone(rmt_channel_t channel, TickType_t waitTicks)
+{
+    if (s_staged & (1 << channel))
+    {
+        // shown again before the others were, send what is staged
+        _start();
+    }
+
+    if (s_staged == 0)
+    {
+        // first channel of the frame, wait for the whole group once
+        for (uint8_t other = 0; other < RMT_CHANNEL_MAX; other++)
+        {
+            if (s_registered & (1 << other))
+            {
+                esp_err_t result = rmt_wait_tx_done(static_cast<rmt_channel_t>(other), waitTicks);
+                if (result != ESP_OK)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t NeoEsp32RmtSyncGroup::Write(rmt_channel_t channel, const uint8_t* data, size_t sizeData)
+{
+    s_data[channel] = data;
+    s_sizeData[channel] = sizeData;
+    s_staged |= (1 << channel);
+
+    if (s_staged == s_registered)
+    {
+        _start();
+    }
+    return ESP_OK;
+}
+
+void NeoEsp32RmtSyncGroup::_start()
+{
+    // every registered channel must start for a sync group to begin, and
+    // the last frame of a channel is still in the buffer it was staged from
+    for (uint8_t channel = 0; channel < RMT_CHANNEL_MAX; channel++)
+    {
+        if ((s_registered & (1 << channel)) && s_data[channel] != nullptr)
+        {
+            ESP_ERROR_CHECK_WITHOUT_ABORT(rmt_write_sample(static_cast<rmt_channel_t>(channel),
+                s_data[channel],
+                s_sizeData[channel],
+                false));
+        }
+    }
+    s_staged = 0;
+}
 
 // translate NeoPixelBuffer into RMT buffer
 // this is done on the fly so we don't require a send buffer in raw RMT format
@@ -49,8 +204,7 @@ void NeoEsp32RmtSpeed::_translate(const void* src,
     size_t wanted_num,
     size_t* translated_size,
     size_t* item_num,
-    const uint32_t rmtBit0,
-    const uint32_t rmtBit1,
+    const uint32_t nibbleItems[16][4],
     const uint16_t rmtDurationReset)
 {
     if (src == NULL || dest == NULL)
@@ -60,47 +214,33 @@ void NeoEsp32RmtSpeed::_translate(const void* src,
         return;
     }
 
-    size_t size = 0;
-    size_t num = 0;
-    const uint8_t* psrc = static_cast<const uint8_t*>(src);
-    rmt_item32_t* pdest = dest;
-
-    for (;;)
-    {
-        uint8_t data = *psrc;
-
-        for (uint8_t bit = 0; bit < 8; bit++)
-        {
-            pdest->val = (data & 0x80) ? rmtBit1 : rmtBit0;
-            pdest++;
-            data <<= 1;
-        }
-        num += 8;
-        size++;
-
-        // if this is the last byte we need to adjust the length of the last pulse
-        if (size >= src_size)
-        {
-            // extend the last bits LOW value to include the full reset signal length
-            pdest--;
-            pdest->duration1 = rmtDurationReset;
-            // and stop updating data to send
-            break;
-        }
-
-        if (num >= wanted_num)
-        {
-            // stop updating data to send
-            break;
-        }
-
-        psrc++;
-    }
-
-    *translated_size = size;
-    *item_num = num;
+    // the table copies replace a bit test per item,
+    // see NeoEsp32RmtTranslators.h
+    NeoEsp32RmtNibbleTranslator::Translate(static_cast<const uint8_t*>(src),
+        reinterpret_cast<uint32_t*>(dest),
+        src_size,
+        wanted_num,
+        translated_size,
+        item_num,
+        nibbleItems,
+        rmtDurationReset);
 }
 
+// the four items of every nibble, built at compile time from the bit items
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeedWs2811::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeedWs2812x::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeedSk6812::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeedTm1814::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeed800Kbps::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeed400Kbps::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtSpeedApa106::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeedWs2811::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeedWs2812x::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeedSk6812::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeedTm1814::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeed800Kbps::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeed400Kbps::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
+const DRAM_ATTR uint32_t NeoEsp32RmtInvertedSpeedApa106::RmtNibbleItems[16][4] = NEO_RMT_NIBBLE_ITEMS(RmtBit0, RmtBit1);
 
 // these are required due to the linker error with ISRs
 // dangerous relocation: l32r: literal placed after use
@@ -114,7 +254,7 @@ void NeoEsp32RmtSpeedWs2811::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtSpeedWs2812x::Translate(const void* src,
@@ -125,7 +265,7 @@ void NeoEsp32RmtSpeedWs2812x::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtSpeedSk6812::Translate(const void* src,
@@ -136,7 +276,7 @@ void NeoEsp32RmtSpeedSk6812::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtSpeedTm1814::Translate(const void* src,
@@ -147,7 +287,7 @@ void NeoEsp32RmtSpeedTm1814::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtSpeed800Kbps::Translate(const void* src,
@@ -158,7 +298,7 @@ void NeoEsp32RmtSpeed800Kbps::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtSpeed400Kbps::Translate(const void* src,
@@ -169,7 +309,7 @@ void NeoEsp32RmtSpeed400Kbps::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtSpeedApa106::Translate(const void* src,
@@ -180,7 +320,7 @@ void NeoEsp32RmtSpeedApa106::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeedWs2811::Translate(const void* src,
@@ -191,7 +331,7 @@ void NeoEsp32RmtInvertedSpeedWs2811::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeedWs2812x::Translate(const void* src,
@@ -202,7 +342,7 @@ void NeoEsp32RmtInvertedSpeedWs2812x::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeedSk6812::Translate(const void* src,
@@ -213,7 +353,7 @@ void NeoEsp32RmtInvertedSpeedSk6812::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeedTm1814::Translate(const void* src,
@@ -224,7 +364,7 @@ void NeoEsp32RmtInvertedSpeedTm1814::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeed800Kbps::Translate(const void* src,
@@ -235,7 +375,7 @@ void NeoEsp32RmtInvertedSpeed800Kbps::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeed400Kbps::Translate(const void* src,
@@ -246,7 +386,7 @@ void NeoEsp32RmtInvertedSpeed400Kbps::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 
 void NeoEsp32RmtInvertedSpeedApa106::Translate(const void* src,
@@ -257,6 +397,6 @@ void NeoEsp32RmtInvertedSpeedApa106::Translate(const void* src,
     size_t* item_num)
 {
     _translate(src, dest, src_size, wanted_num, translated_size, item_num,
-        RmtBit0, RmtBit1, RmtDurationReset);
+        RmtNibbleItems, RmtDurationReset);
 }
 #endif
\ No newline at end of file
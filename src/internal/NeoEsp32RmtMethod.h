@@ -44,12 +44,15 @@ Esp32-hal-rmt.c
 */
 
 #include <Arduino.h>
+#include <esp_log.h>
 
 extern "C"
 {
 #include <driver/rmt.h>
 }
 
+#include "NeoEsp32RmtTranslators.h"
+
 class NeoEsp32RmtSpeed
 {
 public:
@@ -75,8 +78,7 @@ protected:
         size_t wanted_num,
         size_t* translated_size,
         size_t* item_num,
-        const uint32_t rmtBit0,
-        const uint32_t rmtBit1,
+        const uint32_t nibbleItems[16][4],
         const uint16_t rmtDurationReset);
 
 };
@@ -113,6 +115,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(300, 950); 
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(900, 350); 
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(300000); // 300us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -128,6 +131,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 850);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(800, 450);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(300000); // 300us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -143,6 +147,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 850); 
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(800, 450); 
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(80000); // 80us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -159,6 +164,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(360, 890);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(720, 530);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(200000); // 200us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -174,6 +180,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 850); 
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(800, 450); 
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(50000); // 50us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -189,6 +196,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(800, 1700); 
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(1600, 900); 
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(50000); // 50us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -204,6 +212,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 1250);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(1250, 400);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(50000); // 50us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -219,6 +228,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(300, 950);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(900, 350);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(300000); // 300us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -234,6 +244,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 850);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(800, 450);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(300000); // 300us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -249,6 +260,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 850);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(800, 450);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(80000); // 80us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -265,6 +277,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(360, 890);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(720, 530);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(200000); // 200us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -280,6 +293,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 850);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(800, 450);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(50000); // 50us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -295,6 +309,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(800, 1700);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(1600, 900);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(50000); // 50us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -310,6 +325,7 @@ public:
     const static DRAM_ATTR uint32_t RmtBit0 = Item32Val(400, 1250);
     const static DRAM_ATTR uint32_t RmtBit1 = Item32Val(1250, 400);
     const static DRAM_ATTR uint16_t RmtDurationReset = FromNs(50000); // 50us
+    const static DRAM_ATTR uint32_t RmtNibbleItems[16][4];
 
     static void IRAM_ATTR Translate(const void* src,
         rmt_item32_t* dest,
@@ -371,18 +387,173 @@ public:
 
 #endif
 
-template<typename T_SPEED, typename T_CHANNEL> class NeoEsp32RmtMethodBase
+// every RMT channel owns one block of 64 items of RMT memory, a channel can
+// claim the blocks of the channels that follow it so the translator refills
+// less often; those channels can then not be used, for example
+//   NeoEsp32RmtMethodBase<NeoEsp32RmtSpeedWs2812x, NeoEsp32RmtChannel0, NeoEsp32RmtMemoryBlocks<4>>
+// uses the memory of channels 0 to 3
+template<uint8_t V_BLOCKS> class NeoEsp32RmtMemoryBlocks
 {
 public:
+    static_assert(V_BLOCKS >= 1 && V_BLOCKS <= 8, "an RMT channel can use from 1 to 8 memory blocks");
+
+    const static uint8_t RmtMemoryBlockCount = V_BLOCKS;
+};
+
+// tracks the memory blocks claimed by initialized channels,
+// so two channels that overlap are caught when the second starts
+class NeoEsp32RmtMemory
+{
+public:
+    static bool Claim(rmt_channel_t channel, uint8_t blockCount);
+    static void Release(rmt_channel_t channel, uint8_t blockCount);
+
+private:
+    static uint8_t s_claimedBlocks;
+
+    static uint8_t _mask(rmt_channel_t channel, uint8_t blockCount)
+    {
+        return static_cast<uint8_t>(((1 << blockCount) - 1) << channel);
+    }
+};
+
+// NeoEsp32RmtShowComplete hands the transmit end interrupt, which the RMT
+// driver shares between all channels, to the ShowAsync callback of each
+// channel; it replaces any other rmt_register_tx_end_callback
+class NeoEsp32RmtShowComplete
+{
+public:
+    static void Set(rmt_channel_t channel, NeoShowCompleteCallback callback, void* context);
+
+private:
+    static bool s_registered;
+    static volatile NeoShowCompleteCallback s_callbacks[RMT_CHANNEL_MAX];
+    static void* s_contexts[RMT_CHANNEL_MAX];
+
+    static void _txEnd(rmt_channel_t channel, void* arg);
+};
+
+// NeoEsp32RmtSyncNone starts the channel as soon as its bus is shown
+class NeoEsp32RmtSyncNone
+{
+public:
+    static void Register(rmt_channel_t)
+    {
+    }
+
+    static void Unregister(rmt_channel_t)
+    {
+    }
+
+    static bool IsReadyToUpdate(rmt_channel_t channel)
+    {
+        return (ESP_OK == rmt_wait_tx_done(channel, 0));
+    }
+
+    static bool IsWriteDone(rmt_channel_t channel)
+    {
+        return IsReadyToUpdate(channel);
+    }
+
+    const static bool StagesWrites = false;
+
+    static esp_err_t WaitTxDone(rmt_channel_t channel, TickType_t waitTicks)
+    {
+        return rmt_wait_tx_done(channel, waitTicks);
+    }
+
+    static esp_err_t Write(rmt_channel_t channel, const uint8_t* data, size_t sizeData)
+    {
+        return rmt_write_sample(channel, data, sizeData, false);
+    }
+};
+
+// NeoEsp32RmtSyncGroup stages the data of every channel that uses it and
+// starts all of them together once each has been shown, or once one is
+// shown again, so all the strips latch the same frame.  Channels that
+// were not shown resend their last frame.  Where the hardware supports it
+// the channels form an RMT sync group and start on the same clock,
+// otherwise they are started back to back.  Only the first Show of a
+// frame waits for the previous frame of the whole group, and a channel
+// isn't ready to update while it is staged
+class NeoEsp32RmtSyncGroup
+{
+public:
+    static void Register(rmt_channel_t channel);
+    static void Unregister(rmt_channel_t channel);
+    static bool IsReadyToUpdate(rmt_channel_t channel);
+    static bool IsWriteDone(rmt_channel_t channel);
+    static esp_err_t WaitTxDone(rmt_channel_t channel, TickType_t waitTicks);
+    static esp_err_t Write(rmt_channel_t channel, const uint8_t* data, size_t sizeData);
+
+    // Write returns before the data is read
+    const static bool StagesWrites = true;
+
+private:
+    static uint8_t s_registered;   // channels in the group
+    static uint8_t s_staged;       // channels shown since the last start
+    static const uint8_t* s_data[RMT_CHANNEL_MAX];
+    static size_t s_sizeData[RMT_CHANNEL_MAX];
+
+    static void _start();
+};
+
+// NeoEsp32RmtDoubleBuffer lets the pixels be edited while the previous
+// frame is still being sent, at the cost of a second pixel buffer
+class NeoEsp32RmtDoubleBuffer
+{
+public:
+    const static uint8_t RmtBufferCount = 2;
+};
+
+// NeoEsp32RmtSingleBuffer halves the pixel memory and removes the buffer
+// copy from Update; Show then returns once the frame has been sent.
+// With NeoEsp32RmtSyncGroup a staged frame is read when the group starts,
+// so edits made before the last channel of the group is shown are sent.
+// An output scale or rotation needs the second buffer, it is allocated
+// when first set
+class NeoEsp32RmtSingleBuffer
+{
+public:
+    const static uint8_t RmtBufferCount = 1;
+};
+
+// T_SYNC is NeoEsp32RmtSyncNone or NeoEsp32RmtSyncGroup, for example
+//   NeoEsp32RmtMethodBase<NeoEsp32RmtSpeedWs2812x, NeoEsp32RmtChannel0, NeoEsp32RmtMemoryBlocks<1>, NeoEsp32RmtSyncGroup>
+// T_BUFFER is NeoEsp32RmtDoubleBuffer or NeoEsp32RmtSingleBuffer
+template<typename T_SPEED,
+    typename T_CHANNEL,
+    typename T_MEMORY = NeoEsp32RmtMemoryBlocks<1>,
+    typename T_SYNC = NeoEsp32RmtSyncNone,
+    typename T_BUFFER = NeoEsp32RmtDoubleBuffer> class NeoEsp32RmtMethodBase
+{
+public:
+    static_assert(T_CHANNEL::RmtChannelNumber + T_MEMORY::RmtMemoryBlockCount <= RMT_CHANNEL_MAX,
+        "the memory blocks of the RMT channel go past the last channel");
+
+    // a single buffer staged by a sync group is read when the group starts
+    const static bool DefersPixelRead = (T_BUFFER::RmtBufferCount == 1 && T_SYNC::StagesWrites);
+
     NeoEsp32RmtMethodBase(uint8_t pin, uint16_t pixelCount, size_t elementSize, size_t settingsSize)  :
         _sizeData(pixelCount * elementSize + settingsSize),
-        _pin(pin)
+        _sizeSettings(settingsSize),
+        _pin(pin),
+        _outputScale(NeoOutputScaleNone),
+        _outputRotation(0),
+        _claimedMemory(false)
     {
         _dataEditing = static_cast<uint8_t*>(malloc(_sizeData));
         memset(_dataEditing, 0x00, _sizeData);
 
-        _dataSending = static_cast<uint8_t*>(malloc(_sizeData));
-        // no need to initialize it, it gets overwritten on every send
+        if (T_BUFFER::RmtBufferCount > 1)
+        {
+            _dataSending = static_cast<uint8_t*>(malloc(_sizeData));
+            // no need to initialize it, it gets overwritten on every send
+        }
+        else
+        {
+            _dataSending = _dataEditing;
+        }
     }
 
     ~NeoEsp32RmtMethodBase()
@@ -391,26 +562,53 @@ public:
         // arbitrary time out of 10 seconds
         ESP_ERROR_CHECK_WITHOUT_ABORT(rmt_wait_tx_done(T_CHANNEL::RmtChannelNumber, 10000 / portTICK_PERIOD_MS));
 
+        T_SYNC::Unregister(T_CHANNEL::RmtChannelNumber);
         ESP_ERROR_CHECK(rmt_driver_uninstall(T_CHANNEL::RmtChannelNumber));
 
+        // a bus that never began holds no blocks, they may be another's
+        if (_claimedMemory)
+        {
+            NeoEsp32RmtMemory::Release(T_CHANNEL::RmtChannelNumber, T_MEMORY::RmtMemoryBlockCount);
+        }
+
+        if (_dataSending != _dataEditing)
+        {
+            free(_dataSending);
+        }
         free(_dataEditing);
-        free(_dataSending);
     }
 
 
     bool IsReadyToUpdate() const
     {
-        return (ESP_OK == rmt_wait_tx_done(T_CHANNEL::RmtChannelNumber, 0));
+        return T_SYNC::IsReadyToUpdate(T_CHANNEL::RmtChannelNumber);
+    }
+
+    // true once the group is done sending, even while this channel is
+    // staged waiting on the others
+    bool IsWriteDone() const
+    {
+        return T_SYNC::IsWriteDone(T_CHANNEL::RmtChannelNumber);
     }
 
     void Initialize()
     {
         rmt_config_t config;
 
+        if (!_claimedMemory)
+        {
+            if (!NeoEsp32RmtMemory::Claim(T_CHANNEL::RmtChannelNumber, T_MEMORY::RmtMemoryBlockCount))
+            {
+                ESP_LOGE("NEOPIXL", "RMT channel %u memory blocks overlap another channel", T_CHANNEL::RmtChannelNumber);
+                ESP_ERROR_CHECK(ESP_ERR_INVALID_STATE);
+            }
+            _claimedMemory = true;
+        }
+
         config.rmt_mode = RMT_MODE_TX;
         config.channel = T_CHANNEL::RmtChannelNumber;
         config.gpio_num = static_cast<gpio_num_t>(_pin);
-        config.mem_block_num = 1;
+        config.mem_block_num = T_MEMORY::RmtMemoryBlockCount;
         config.tx_config.loop_en = false;
         
         config.tx_config.idle_output_en = true;
@@ -424,6 +622,7 @@ public:
         ESP_ERROR_CHECK(rmt_config(&config));
         ESP_ERROR_CHECK(rmt_driver_install(T_CHANNEL::RmtChannelNumber, 0, ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_LEVEL1));
         ESP_ERROR_CHECK(rmt_translator_init(T_CHANNEL::RmtChannelNumber, T_SPEED::Translate));
+        T_SYNC::Register(T_CHANNEL::RmtChannelNumber);
     }
 
     void Update(bool maintainBufferConsistency)
@@ -431,10 +630,46 @@ public:
         // wait for not actively sending data
         // this will time out at 10 seconds, an arbitrarily long period of time
         // and do nothing if this happens
-        if (ESP_OK == ESP_ERROR_CHECK_WITHOUT_ABORT(rmt_wait_tx_done(T_CHANNEL::RmtChannelNumber, 10000 / portTICK_PERIOD_MS)))
+        if (ESP_OK == ESP_ERROR_CHECK_WITHOUT_ABORT(T_SYNC::WaitTxDone(T_CHANNEL::RmtChannelNumber, 10000 / portTICK_PERIOD_MS)))
         {
+            if (_outputScale != NeoOutputScaleNone || _outputRotation != 0)
+            {
+                // the translator has no per channel context, so the scale
+                // and rotation are applied while copying into the sending
+                // buffer; the editing buffer keeps the data as it is and
+                // isn't swapped
+                if (_outputRotation == 0)
+                {
+                    memcpy(_dataSending, _dataEditing, _sizeSettings);
+                    NeoScaleBytes(_dataSending + _sizeSettings,
+                        _dataEditing + _sizeSettings,
+                        _sizeData - _sizeSettings,
+                        _outputScale);
+                }
+                else
+                {
+                    uint8_t* dataSending = _dataSending;
+
+                    NeoEncodeRotated(_dataEditing, 0, _sizeData, _sizeData, _sizeSettings, _outputRotation, _outputScale,
+                        [dataSending](size_t offsetSent, const uint8_t* pBytes, size_t countBytes)
+                        {
+                            memcpy(dataSending + offsetSent, pBytes, countBytes);
+                        });
+                }
+                ESP_ERROR_CHECK_WITHOUT_ABORT(T_SYNC::Write(T_CHANNEL::RmtChannelNumber, _dataSending, _sizeData));
+                return;
+            }
+
             // now start the RMT transmit with the editing buffer before we swap
-            ESP_ERROR_CHECK_WITHOUT_ABORT(rmt_write_sample(T_CHANNEL::RmtChannelNumber, _dataEditing, _sizeData, false));
+            ESP_ERROR_CHECK_WITHOUT_ABORT(T_SYNC::Write(T_CHANNEL::RmtChannelNumber, _dataEditing, _sizeData));
+
+            if (T_BUFFER::RmtBufferCount == 1)
+            {
+                // the RMT translates from the only buffer as it sends,
+                // so it can't be edited until the send is done
+                ESP_ERROR_CHECK_WITHOUT_ABORT(rmt_wait_tx_done(T_CHANNEL::RmtChannelNumber, 10000 / portTICK_PERIOD_MS));
+                return;
+            }
 
             if (maintainBufferConsistency)
             {
@@ -449,6 +684,38 @@ public:
         }
     }
 
+    // callback is called from the RMT ISR once the next send of the
+    // channel is done
+    void SetCompleteCallback(NeoShowCompleteCallback callback, void* context)
+    {
+        NeoEsp32RmtShowComplete::Set(T_CHANNEL::RmtChannelNumber, callback, context);
+    }
+
+    // a single buffer has nowhere to put the scaled data while it is
+    // sent, so the first scale allocates a sending buffer for it
+    bool SetOutputScale(uint16_t scale)
+    {
+        if (scale != NeoOutputScaleNone && !_allocateSending())
+        {
+            return false;
+        }
+        _outputScale = scale;
+        return true;
+    }
+
+    // the pixels are sent starting from the pixel rotation bytes in
+    // (a whole number of pixels), the ones before it wrap to the end;
+    // as with the scale, a single buffer allocates a sending buffer
+    bool SetOutputRotation(size_t rotation)
+    {
+        if (rotation != 0 && !_allocateSending())
+        {
+            return false;
+        }
+        _outputRotation = rotation;
+        return true;
+    }
+
     uint8_t* getData() const
     {
         return _dataEditing;
@@ -461,11 +728,31 @@ public:
 
 private:
     const size_t  _sizeData;      // Size of '_data*' buffers 
+    const size_t  _sizeSettings;  // settings in front of the pixels, never scaled
     const uint8_t _pin;            // output pin number
+    uint16_t _outputScale;         // 8.8 scale applied to the pixels as they are sent
+    size_t _outputRotation;        // bytes into the pixels that are sent first
+    bool _claimedMemory;           // Initialize claimed the memory blocks
 
     // Holds data stream which include LED color values and other settings as needed
     uint8_t*  _dataEditing;   // exposed for get and set
     uint8_t*  _dataSending;   // used for async send using RMT
+
+    // a single buffer gets a sending buffer of its own the first time the
+    // data must be changed on its way out
+    bool _allocateSending()
+    {
+        if (_dataSending == _dataEditing)
+        {
+            uint8_t* dataSending = static_cast<uint8_t*>(malloc(_sizeData));
+            if (dataSending == nullptr)
+            {
+                return false;
+            }
+            _dataSending = dataSending;
+        }
+        return true;
+    }
 };
 
 // normal
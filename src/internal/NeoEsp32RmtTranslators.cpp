@@ -0,0 +1,144 @@
+/*-------------------------------------------------------------------------
+NeoEsp32RmtTranslators provides the translators that convert the pixel
+data stream into the RMT items sent by NeoEsp32RmtMethodBase.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include "NeoPixelBus.h"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(NEOPIXELBUS_HOST)
+
+// replaces duration1 (the low time) of the last item with the reset time
+static inline uint32_t IRAM_ATTR ExtendLastItem(uint32_t item, uint16_t rmtDurationReset)
+{
+    return (item & 0x8000ffff) | (static_cast<uint32_t>(rmtDurationReset & 0x7fff) << 16);
+}
+
+void NeoEsp32RmtBitTranslator::Translate(const uint8_t* src,
+    uint32_t* dest,
+    size_t src_size,
+    size_t wanted_num,
+    size_t* translated_size,
+    size_t* item_num,
+    const uint32_t rmtBit0,
+    const uint32_t rmtBit1,
+    const uint16_t rmtDurationReset)
+{
+    size_t size = 0;
+    size_t num = 0;
+    const uint8_t* psrc = src;
+    uint32_t* pdest = dest;
+
+    for (;;)
+    {
+        uint8_t data = *psrc;
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            *pdest = (data & 0x80) ? rmtBit1 : rmtBit0;
+            pdest++;
+            data <<= 1;
+        }
+        num += 8;
+        size++;
+
+        // if this is the last byte we need to adjust the length of the last pulse
+        if (size >= src_size)
+        {
+            // extend the last bits LOW value to include the full reset signal length
+            pdest--;
+            *pdest = ExtendLastItem(*pdest, rmtDurationReset);
+            // and stop updating data to send
+            break;
+        }
+
+        if (num >= wanted_num)
+        {
+            // stop updating data to send
+            break;
+        }
+
+        psrc++;
+    }
+
+    *translated_size = size;
+    *item_num = num;
+}
+
+void NeoEsp32RmtNibbleTranslator::Translate(const uint8_t* src,
+    uint32_t* dest,
+    size_t src_size,
+    size_t wanted_num,
+    size_t* translated_size,
+    size_t* item_num,
+    const uint32_t nibbleItems[16][4],
+    const uint16_t rmtDurationReset)
+{
+    // wanted_num rounded up to whole bytes gives the same stopping
+    // point as the bit translator, which always translates one byte
+    size_t size = (wanted_num + 7) / 8;
+    if (size > src_size)
+    {
+        size = src_size;
+    }
+    if (size == 0)
+    {
+        size = 1;
+    }
+    bool last = (size >= src_size);
+
+    const uint8_t* psrc = src;
+    const uint8_t* psrcEnd = src + size;
+    uint32_t* pdest = dest;
+
+    while (psrc < psrcEnd)
+    {
+        const uint32_t* pHigh = nibbleItems[*psrc >> 4];
+        const uint32_t* pLow = nibbleItems[*psrc & 0x0f];
+
+        pdest[0] = pHigh[0];
+        pdest[1] = pHigh[1];
+        pdest[2] = pHigh[2];
+        pdest[3] = pHigh[3];
+        pdest[4] = pLow[0];
+        pdest[5] = pLow[1];
+        pdest[6] = pLow[2];
+        pdest[7] = pLow[3];
+
+        pdest += 8;
+        psrc++;
+    }
+
+    if (last)
+    {
+        // extend the last bits LOW value to include the full reset signal length
+        pdest[-1] = ExtendLastItem(pdest[-1], rmtDurationReset);
+    }
+
+    *translated_size = size;
+    *item_num = size * 8;
+}
+
+#endif
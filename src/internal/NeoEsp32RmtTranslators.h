@@ -0,0 +1,79 @@
+/*-------------------------------------------------------------------------
+NeoEsp32RmtTranslators provides the translators that convert the pixel
+data stream into the RMT items sent by NeoEsp32RmtMethodBase.
+They are platform neutral so they can be benchmarked on a host.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+// the items are the val of rmt_item32_t; duration0 is bits 0-14, level0 bit 15,
+// duration1 bits 16-30 and level1 bit 31.  Both translators write 8 items for
+// every data byte, most significant bit first, until src_size bytes are done or
+// at least wanted_num items are written; the low duration of the very last item
+// is extended to rmtDurationReset
+
+// expands to the initializer of a [16][4] item table, the four items
+// of every nibble value, built at compile time from the 0 and 1 bit items
+#define NEO_RMT_NIBBLE_ITEM(n, b0, b1) \
+    { ((n) & 8) ? (b1) : (b0), ((n) & 4) ? (b1) : (b0), ((n) & 2) ? (b1) : (b0), ((n) & 1) ? (b1) : (b0) }
+
+#define NEO_RMT_NIBBLE_ITEMS(b0, b1) \
+{ \
+    NEO_RMT_NIBBLE_ITEM(0, b0, b1), NEO_RMT_NIBBLE_ITEM(1, b0, b1), NEO_RMT_NIBBLE_ITEM(2, b0, b1), NEO_RMT_NIBBLE_ITEM(3, b0, b1), \
+    NEO_RMT_NIBBLE_ITEM(4, b0, b1), NEO_RMT_NIBBLE_ITEM(5, b0, b1), NEO_RMT_NIBBLE_ITEM(6, b0, b1), NEO_RMT_NIBBLE_ITEM(7, b0, b1), \
+    NEO_RMT_NIBBLE_ITEM(8, b0, b1), NEO_RMT_NIBBLE_ITEM(9, b0, b1), NEO_RMT_NIBBLE_ITEM(10, b0, b1), NEO_RMT_NIBBLE_ITEM(11, b0, b1), \
+    NEO_RMT_NIBBLE_ITEM(12, b0, b1), NEO_RMT_NIBBLE_ITEM(13, b0, b1), NEO_RMT_NIBBLE_ITEM(14, b0, b1), NEO_RMT_NIBBLE_ITEM(15, b0, b1) \
+}
+
+// NeoEsp32RmtBitTranslator selects the item for every bit;
+// it is the reference the nibble translator is verified against
+class NeoEsp32RmtBitTranslator
+{
+public:
+    static void IRAM_ATTR Translate(const uint8_t* src,
+        uint32_t* dest,
+        size_t src_size,
+        size_t wanted_num,
+        size_t* translated_size,
+        size_t* item_num,
+        const uint32_t rmtBit0,
+        const uint32_t rmtBit1,
+        const uint16_t rmtDurationReset);
+};
+
+// NeoEsp32RmtNibbleTranslator copies the four prebuilt items of every
+// nibble from a NEO_RMT_NIBBLE_ITEMS table, so no bit is tested
+class NeoEsp32RmtNibbleTranslator
+{
+public:
+    static void IRAM_ATTR Translate(const uint8_t* src,
+        uint32_t* dest,
+        size_t src_size,
+        size_t wanted_num,
+        size_t* translated_size,
+        size_t* item_num,
+        const uint32_t nibbleItems[16][4],
+        const uint16_t rmtDurationReset);
+};
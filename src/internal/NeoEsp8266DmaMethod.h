@@ -53,6 +53,8 @@ extern "C"
 #endif
 }
 
+#include "NeoEsp8266Encoders.h"
+
 struct slc_queue_item
 {
     uint32  blocksize : 12;
@@ -65,42 +67,6 @@ struct slc_queue_item
     uint32  next_link_ptr;
 };
 
-class NeoEsp8266DmaSpeedBase
-{
-public:
-    static const uint8_t Level = 0x00;
-    static uint16_t Convert(uint8_t value)
-    {
-        const uint16_t bitpatterns[16] =
-        {
-            0b1000100010001000, 0b1000100010001110, 0b1000100011101000, 0b1000100011101110,
-            0b1000111010001000, 0b1000111010001110, 0b1000111011101000, 0b1000111011101110,
-            0b1110100010001000, 0b1110100010001110, 0b1110100011101000, 0b1110100011101110,
-            0b1110111010001000, 0b1110111010001110, 0b1110111011101000, 0b1110111011101110,
-        };
-
-        return bitpatterns[value];
-    }
-};
-
-class NeoEsp8266DmaInvertedSpeedBase
-{
-public:
-    static const uint8_t Level = 0xFF;
-    static uint16_t Convert(uint8_t value)
-    {
-        const uint16_t bitpatterns[16] =
-        {
-            0b0111011101110111, 0b0111011101110001, 0b0111011100010111, 0b0111011100010001,
-            0b0111000101110111, 0b0111000101110001, 0b0111000100010111, 0b0111000100010001,
-            0b0001011101110111, 0b0001011101110001, 0b0001011100010111, 0b0001011100010001,
-            0b0001000101110111, 0b0001000101110001, 0b0001000100010111, 0b0001000100010001,
-        };
-
-        return bitpatterns[value];
-    }
-};
-
 class NeoEsp8266DmaSpeed800KbpsBase : public NeoEsp8266DmaSpeedBase
 {
 public:
@@ -218,7 +184,12 @@ template<typename T_SPEED> class NeoEsp8266DmaMethodBase
 {
 public:
     NeoEsp8266DmaMethodBase(uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
-        _sizeData(pixelCount * elementSize + settingsSize)
+        _sizeData(pixelCount * elementSize + settingsSize),
+        _sizeSettings(settingsSize),
+        _completeCallback(nullptr),
+        _completeContext(nullptr),
+        _outputScale(NeoOutputScaleNone),
+        _outputRotation(0)
     {
         uint16_t dmaPixelSize = c_dmaBytesPerPixelBytes * elementSize;
         uint16_t dmaSettingsSize = c_dmaBytesPerPixelBytes * settingsSize;
@@ -390,19 +361,49 @@ public:
         I2SC |= I2STXS; // Start transmission
     }
 
-    void ICACHE_RAM_ATTR Update(bool)
+    void ICACHE_RAM_ATTR Update(bool maintainBufferConsistency)
+    {
+        Update(maintainBufferConsistency, 0, _sizeData);
+    }
+
+    // the DMA buffer keeps the encoding of the last update, so only the
+    // bytes from dirtyOffset for dirtySize need to be encoded again
+    void ICACHE_RAM_ATTR Update(bool, size_t dirtyOffset, size_t dirtySize)
     {
         // wait for not actively sending data
         while (!IsReadyToUpdate())
         {
             yield();
         }
-        FillBuffers();
+        FillBuffers(dirtyOffset, dirtySize);
         
         // toggle state so the ISR reacts
         _dmaState = NeoDmaState_Pending;
     }
 
+    // the pixels are scaled as they are encoded
+    bool SetOutputScale(uint16_t scale)
+    {
+        _outputScale = scale;
+        return true;
+    }
+
+    // the pixels are sent starting from the pixel rotation bytes in
+    // (a whole number of pixels), the ones before it wrap to the end
+    bool SetOutputRotation(size_t rotation)
+    {
+        _outputRotation = rotation;
+        return true;
+    }
+
+    // callback is called from the DMA ISR once the next update is sent
+    void SetCompleteCallback(NeoShowCompleteCallback callback, void* context)
+    {
+        _completeCallback = nullptr;
+        _completeContext = context;
+        _completeCallback = callback;
+    }
+
     uint8_t* getData() const
     {
         return _data;
@@ -417,6 +418,7 @@ private:
     static NeoEsp8266DmaMethodBase* s_this; // for the ISR
 
     const size_t  _sizeData;    // Size of '_data' buffer 
+    const size_t  _sizeSettings; // settings in front of the pixels, never scaled
     uint8_t*  _data;        // Holds LED color values
 
     size_t _i2sBufferSize; // total size of _i2sBuffer
@@ -433,6 +435,12 @@ private:
 
     volatile NeoDmaState _dmaState;
 
+    volatile NeoShowCompleteCallback _completeCallback; // called once by the ISR when idle again
+    void* _completeContext;
+
+    uint16_t _outputScale; // 8.8 scale applied to the pixels as they are encoded
+    size_t _outputRotation; // bytes into the pixels that are sent first
+
     // This routine is called as soon as the DMA routine has something to tell us. All we
     // handle here is the RX_EOF_INT status, which indicate the DMA has sent a buffer whose
     // descriptor has the 'EOF' field set to 1.
@@ -479,6 +487,13 @@ private:
 
             case NeoDmaState_Zeroing:
                 s_this->_dmaState = NeoDmaState_Idle;
+                if (s_this->_completeCallback != nullptr)
+                {
+                    NeoShowCompleteCallback callback = s_this->_completeCallback;
+
+                    s_this->_completeCallback = nullptr;
+                    callback(s_this->_completeContext);
+                }
                 break;
             }
         }
@@ -486,15 +501,13 @@ private:
         ETS_SLC_INTR_ENABLE();
     }
 
-    void FillBuffers()
+    void FillBuffers(size_t offset, size_t size)
     {
-        uint16_t* pDma = (uint16_t*)_i2sBuffer;
-        uint8_t* pEnd = _data + _sizeData;
-        for (uint8_t* pData = _data; pData < pEnd; pData++)
-        {
-            *(pDma++) = T_SPEED::Convert(((*pData) & 0x0f));
-            *(pDma++) = T_SPEED::Convert(((*pData) >> 4) & 0x0f);
-        }
+        NeoEncodeRotated(_data, offset, size, _sizeData, _sizeSettings, _outputRotation, _outputScale,
+            [this](size_t offsetBytes, const uint8_t* pBytes, size_t countBytes)
+            {
+                NeoEsp8266DmaEncoder<T_SPEED>::Encode(_i2sBuffer + offsetBytes * c_dmaBytesPerPixelBytes, pBytes, countBytes);
+            });
     }
 
     void StopDma()
@@ -0,0 +1,114 @@
+/*-------------------------------------------------------------------------
+NeoEsp8266Encoders provides the conversions of the pixel data stream into
+the I2S DMA bit stream of NeoEsp8266DmaMethodBase and the UART bytes of
+NeoEsp8266Uart.  They are platform neutral so they can be benchmarked on
+a host.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+class NeoEsp8266DmaSpeedBase
+{
+public:
+    static const uint8_t Level = 0x00;
+    static uint16_t Convert(uint8_t value)
+    {
+        const uint16_t bitpatterns[16] =
+        {
+            0b1000100010001000, 0b1000100010001110, 0b1000100011101000, 0b1000100011101110,
+            0b1000111010001000, 0b1000111010001110, 0b1000111011101000, 0b1000111011101110,
+            0b1110100010001000, 0b1110100010001110, 0b1110100011101000, 0b1110100011101110,
+            0b1110111010001000, 0b1110111010001110, 0b1110111011101000, 0b1110111011101110,
+        };
+
+        return bitpatterns[value];
+    }
+};
+
+class NeoEsp8266DmaInvertedSpeedBase
+{
+public:
+    static const uint8_t Level = 0xFF;
+    static uint16_t Convert(uint8_t value)
+    {
+        const uint16_t bitpatterns[16] =
+        {
+            0b0111011101110111, 0b0111011101110001, 0b0111011100010111, 0b0111011100010001,
+            0b0111000101110111, 0b0111000101110001, 0b0111000100010111, 0b0111000100010001,
+            0b0001011101110111, 0b0001011101110001, 0b0001011100010111, 0b0001011100010001,
+            0b0001000101110111, 0b0001000101110001, 0b0001000100010111, 0b0001000100010001,
+        };
+
+        return bitpatterns[value];
+    }
+};
+
+// every data byte is two 16 bit DMA words, the low nibble first
+template<typename T_SPEED> class NeoEsp8266DmaEncoder
+{
+public:
+    static void Encode(uint8_t* pDmaBuffer, const uint8_t* pData, size_t sizeData)
+    {
+        uint16_t* pDma = reinterpret_cast<uint16_t*>(pDmaBuffer);
+        const uint8_t* pEnd = pData + sizeData;
+        for (const uint8_t* pPixel = pData; pPixel < pEnd; pPixel++)
+        {
+            *(pDma++) = T_SPEED::Convert(((*pPixel) & 0x0f));
+            *(pDma++) = T_SPEED::Convert(((*pPixel) >> 4) & 0x0f);
+        }
+    }
+};
+
+// the UART byte sent for every two data bits.  UARTs send the least
+// significant bit first, so pushing ABCDEF sends 0FEDCBA1 with the start
+// and stop bits, and the UART is set to invert the levels; a macro so
+// the FIFO fill, which runs from the ISR, keeps the table on its stack
+#define NEO_ESP8266_UART_SYMBOLS \
+    { \
+        0b110111, /* On wire: 1 000 100 0 [Neopixel reads 00] */ \
+        0b000111, /* On wire: 1 000 111 0 [Neopixel reads 01] */ \
+        0b110100, /* On wire: 1 110 100 0 [Neopixel reads 10] */ \
+        0b000100, /* On wire: 1 110 111 0 [NeoPixel reads 11] */ \
+    }
+
+// every data byte is four UART bytes, the most significant bits first
+class NeoEsp8266UartEncoder
+{
+public:
+    static void Encode(uint8_t* pUart, const uint8_t* pData, size_t sizeData)
+    {
+        const uint8_t symbols[4] = NEO_ESP8266_UART_SYMBOLS;
+
+        const uint8_t* pEnd = pData + sizeData;
+        for (const uint8_t* pPixel = pData; pPixel < pEnd; pPixel++)
+        {
+            uint8_t subpix = *pPixel;
+            *(pUart++) = symbols[(subpix >> 6) & 0x3];
+            *(pUart++) = symbols[(subpix >> 4) & 0x3];
+            *(pUart++) = symbols[(subpix >> 2) & 0x3];
+            *(pUart++) = symbols[subpix & 0x3];
+        }
+    }
+};
@@ -36,16 +36,8 @@ const volatile uint8_t* ICACHE_RAM_ATTR NeoEsp8266UartContext::FillUartFifo(uint
     const volatile uint8_t* start,
     const volatile uint8_t* end)
 {
-    // Remember: UARTs send less significant bit (LSB) first so
-    //      pushing ABCDEF byte will generate a 0FEDCBA1 signal,
-    //      including a LOW(0) start & a HIGH(1) stop bits.
-    // Also, we have configured UART to invert logic levels, so:
-    const uint8_t _uartData[4] = {
-        0b110111, // On wire: 1 000 100 0 [Neopixel reads 00]
-        0b000111, // On wire: 1 000 111 0 [Neopixel reads 01]
-        0b110100, // On wire: 1 110 100 0 [Neopixel reads 10]
-        0b000100, // On wire: 1 110 111 0 [NeoPixel reads 11]
-    };
+    // the same bytes NeoEsp8266UartEncoder writes
+    const uint8_t _uartData[4] = NEO_ESP8266_UART_SYMBOLS;
     uint8_t avail = (UART_TX_FIFO_SIZE - GetTxFifoLength(uartNum)) / 4;
     if (end - start > avail)
     {
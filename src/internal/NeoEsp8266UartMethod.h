@@ -28,6 +28,7 @@ License along with NeoPixel.  If not, see
 
 #ifdef ARDUINO_ARCH_ESP8266
 #include <Arduino.h>
+#include "NeoEsp8266Encoders.h"
 
 // this template method class is used to track the data being sent on the uart
 // when using the default serial ISR installed by the core
@@ -0,0 +1,113 @@
+/*-------------------------------------------------------------------------
+NeoFrameQueue is a lock free triple buffer that hands complete frames from
+one producer (the render loop) to one consumer (the output task).
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+
+// The three frames are owned by the producer (back), the consumer (front)
+// and neither (ready).  Publish and Acquire exchange their frame with the
+// ready one, so neither side ever waits on the other; a frame published
+// before the consumer took the previous one replaces it
+class NeoFrameQueue
+{
+public:
+    NeoFrameQueue(size_t sizeFrame) :
+        _sizeFrame(sizeFrame),
+        _back(0),
+        _front(2),
+        _ready(1)
+    {
+        _frames = static_cast<uint8_t*>(malloc(_sizeFrame * 3));
+        memset(_frames, 0x00, _sizeFrame * 3);
+    }
+
+    ~NeoFrameQueue()
+    {
+        free(_frames);
+    }
+
+    size_t FrameSize() const
+    {
+        return _sizeFrame;
+    }
+
+    // producer side, the frame being rendered
+    uint8_t* Back()
+    {
+        return _frame(_back);
+    }
+
+    const uint8_t* Back() const
+    {
+        return _frame(_back);
+    }
+
+    // producer side, hands the back frame over and takes a free one;
+    // returns the frame just published, which stays readable until the
+    // next Publish
+    const uint8_t* Publish()
+    {
+        uint8_t published = _back;
+
+        _back = _ready.exchange(published | FreshFlag, std::memory_order_acq_rel) & IndexMask;
+        return _frame(published);
+    }
+
+    // consumer side, takes the newest published frame if there is one
+    bool Acquire()
+    {
+        if (!(_ready.load(std::memory_order_acquire) & FreshFlag))
+        {
+            return false;
+        }
+
+        _front = _ready.exchange(_front, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    // consumer side, the frame taken by the last Acquire
+    const uint8_t* Front() const
+    {
+        return _frame(_front);
+    }
+
+private:
+    static const uint8_t IndexMask = 0x03;
+    static const uint8_t FreshFlag = 0x80; // set on ready by Publish, cleared by Acquire
+
+    const size_t _sizeFrame;
+    uint8_t* _frames;
+    uint8_t _back;                  // owned by the producer
+    uint8_t _front;                 // owned by the consumer
+    std::atomic<uint8_t> _ready;    // shared
+
+    uint8_t* _frame(uint8_t index) const
+    {
+        return _frames + index * _sizeFrame;
+    }
+};
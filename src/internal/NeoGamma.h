@@ -49,6 +49,32 @@ private:
     static const uint8_t _table[256];
 };
 
+// NeoGamma16Table maps an 8 bit value to an 8.8 fixed point value, so the
+// low end keeps the fraction the 8 bit tables round away; it uses 512 bytes
+// and is built at runtime for any gamma and white level (the largest 8 bit
+// value the channel reaches, for white balance)
+class NeoGamma16Table
+{
+public:
+    static const uint16_t Max = 255 * 256;
+
+    void Build(float gamma, uint8_t white = 255)
+    {
+        for (uint16_t value = 0; value < 256; value++)
+        {
+            float corrected = pow(value / 255.0f, gamma) * white * 256.0f + 0.5f;
+            _table[value] = (corrected > Max) ? Max : static_cast<uint16_t>(corrected);
+        }
+    }
+
+    uint16_t Correct(uint8_t value) const
+    {
+        return _table[value];
+    }
+
+private:
+    uint16_t _table[256];
+};
 
 // use one of the method classes above as a converter for this template class
 template<typename T_METHOD> class NeoGamma
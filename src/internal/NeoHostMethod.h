@@ -0,0 +1,128 @@
+/*-------------------------------------------------------------------------
+NeoPixel library helper functions for host (desktop) builds.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+#if defined(NEOPIXELBUS_HOST)
+
+// NeoHostMethod keeps the data stream in memory and never sends it anywhere.
+// It follows the same contract as the hardware methods so the full template
+// pipeline (features, buffers, topologies, animator) can be built and
+// profiled on a desktop OS against the Arduino shim found in extras/host
+//
+class NeoHostMethod
+{
+public:
+    NeoHostMethod(uint8_t pin, uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
+        _sizeData(pixelCount * elementSize + settingsSize),
+        _pin(pin),
+        _countUpdates(0)
+    {
+        _data = static_cast<uint8_t*>(malloc(_sizeData));
+        memset(_data, 0x00, _sizeData);
+    }
+
+    NeoHostMethod(uint8_t pinClock, uint8_t, uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
+        NeoHostMethod(pinClock, pixelCount, elementSize, settingsSize)
+    {
+    }
+
+    NeoHostMethod(uint16_t pixelCount, size_t elementSize, size_t settingsSize) :
+        NeoHostMethod(0, pixelCount, elementSize, settingsSize)
+    {
+    }
+
+    ~NeoHostMethod()
+    {
+        free(_data);
+    }
+
+    bool IsReadyToUpdate() const
+    {
+        return true; // nothing is ever on the wire
+    }
+
+    void Initialize()
+    {
+        pinMode(_pin, OUTPUT);
+    }
+
+    void Update(bool)
+    {
+        _countUpdates++;
+    }
+
+    uint8_t* getData() const
+    {
+        return _data;
+    };
+
+    size_t getDataSize() const
+    {
+        return _sizeData;
+    }
+
+    // number of times Update was called, useful to confirm
+    // that the dirty tracking skipped a Show
+    uint32_t UpdateCount() const
+    {
+        return _countUpdates;
+    }
+
+private:
+    const size_t  _sizeData;    // Size of '_data' buffer
+    const uint8_t _pin;         // output pin number, only for the shim
+
+    uint32_t _countUpdates;     // count of Update calls
+    uint8_t* _data;             // Holds LED color values
+};
+
+// the host method is the default method for host builds
+typedef NeoHostMethod NeoWs2813Method;
+typedef NeoHostMethod NeoWs2812xMethod;
+typedef NeoHostMethod NeoWs2812Method;
+typedef NeoHostMethod NeoWs2811Method;
+typedef NeoHostMethod NeoSk6812Method;
+typedef NeoHostMethod NeoTm1814Method;
+typedef NeoHostMethod NeoLc8812Method;
+typedef NeoHostMethod NeoApa106Method;
+
+typedef NeoHostMethod Neo800KbpsMethod;
+typedef NeoHostMethod Neo400KbpsMethod;
+
+typedef NeoHostMethod NeoWs2813InvertedMethod;
+typedef NeoHostMethod NeoWs2812xInvertedMethod;
+typedef NeoHostMethod NeoWs2812InvertedMethod;
+typedef NeoHostMethod NeoWs2811InvertedMethod;
+typedef NeoHostMethod NeoSk6812InvertedMethod;
+typedef NeoHostMethod NeoTm1814InvertedMethod;
+typedef NeoHostMethod NeoLc8812InvertedMethod;
+typedef NeoHostMethod NeoApa106InvertedMethod;
+
+typedef NeoHostMethod Neo800KbpsInvertedMethod;
+typedef NeoHostMethod Neo400KbpsInvertedMethod;
+
+#endif
@@ -26,6 +26,11 @@ License along with NeoPixel.  If not, see
 -------------------------------------------------------------------------*/
 #pragma once
 
+// every policy also has HueBlend16 to blend uint16_t hues, where 65536
+// would be a full turn of the wheel (1.0f), with a uint16_t progress
+// (0 - 65535); it isn't a HueBlend overload so double and int arguments
+// still go to the float one. The unsigned
+// math wraps around the wheel by itself so no fix up is needed
 class NeoHueBlendBase
 {
 protected:
@@ -41,6 +46,24 @@ protected:
         }
         return value;
     }
+
+    // the part of distance (up to a full turn) that progress has covered;
+    // a full turn at full progress wraps to 0, which is the same hue
+    static uint16_t Covered(uint32_t distance, uint16_t progress)
+    {
+        uint32_t weight = static_cast<uint32_t>(progress) + (progress >> 15);
+        return static_cast<uint16_t>((distance * weight) >> 16);
+    }
+
+    static uint16_t Clockwise(uint16_t left, uint32_t distance, uint16_t progress)
+    {
+        return left + Covered(distance, progress);
+    }
+
+    static uint16_t CounterClockwise(uint16_t left, uint32_t distance, uint16_t progress)
+    {
+        return left - Covered(distance, progress);
+    }
 };
 
 class NeoHueBlendShortestDistance : NeoHueBlendBase
@@ -62,6 +85,17 @@ public:
         }
         return FixWrap(base + (delta) * progress);
     };
+
+    // half a turn goes clockwise
+    static uint16_t HueBlend16(uint16_t left, uint16_t right, uint16_t progress)
+    {
+        uint16_t distance = right - left;
+        if (distance <= 0x8000)
+        {
+            return Clockwise(left, distance, progress);
+        }
+        return CounterClockwise(left, 0x10000 - distance, progress);
+    };
 };
 
 class NeoHueBlendLongestDistance : NeoHueBlendBase
@@ -83,6 +117,17 @@ public:
         }
         return FixWrap(base + delta * progress);
     };
+
+    // the same hue goes a full turn counter clockwise, as the float one does
+    static uint16_t HueBlend16(uint16_t left, uint16_t right, uint16_t progress)
+    {
+        uint16_t distance = right - left;
+        if (distance >= 0x8000)
+        {
+            return Clockwise(left, distance, progress);
+        }
+        return CounterClockwise(left, 0x10000 - distance, progress);
+    };
 };
 
 class NeoHueBlendClockwiseDirection : NeoHueBlendBase
@@ -99,6 +144,11 @@ public:
 
         return FixWrap(base + delta * progress);
     };
+
+    static uint16_t HueBlend16(uint16_t left, uint16_t right, uint16_t progress)
+    {
+        return Clockwise(left, static_cast<uint16_t>(right - left), progress);
+    };
 };
 
 class NeoHueBlendCounterClockwiseDirection : NeoHueBlendBase
@@ -115,4 +165,9 @@ public:
 
         return FixWrap(base + delta * progress);
     };
+
+    static uint16_t HueBlend16(uint16_t left, uint16_t right, uint16_t progress)
+    {
+        return CounterClockwise(left, static_cast<uint16_t>(left - right), progress);
+    };
 };
@@ -0,0 +1,96 @@
+/*-------------------------------------------------------------------------
+NeoHueTable provides the fully saturated colors of the 8 bit hues
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include "NeoPixelBus.h"
+
+// R, G, B of every hue; each sixth of the wheel ramps one channel
+const uint8_t NeoHueTable::_table[256 * 3] = {
+    255,   0,   0, 255,   6,   0, 255,  12,   0, 255,  18,   0,
+    255,  24,   0, 255,  30,   0, 255,  36,   0, 255,  42,   0,
+    255,  48,   0, 255,  54,   0, 255,  60,   0, 255,  66,   0,
+    255,  72,   0, 255,  78,   0, 255,  84,   0, 255,  90,   0,
+    255,  96,   0, 255, 102,   0, 255, 108,   0, 255, 114,   0,
+    255, 120,   0, 255, 126,   0, 255, 132,   0, 255, 138,   0,
+    255, 144,   0, 255, 150,   0, 255, 156,   0, 255, 162,   0,
+    255, 168,   0, 255, 174,   0, 255, 180,   0, 255, 186,   0,
+    255, 192,   0, 255, 198,   0, 255, 204,   0, 255, 210,   0,
+    255, 216,   0, 255, 222,   0, 255, 228,   0, 255, 234,   0,
+    255, 240,   0, 255, 246,   0, 255, 252,   0, 253, 255,   0,
+    247, 255,   0, 241, 255,   0, 235, 255,   0, 229, 255,   0,
+    223, 255,   0, 217, 255,   0, 211, 255,   0, 205, 255,   0,
+    199, 255,   0, 193, 255,   0, 187, 255,   0, 181, 255,   0,
+    175, 255,   0, 169, 255,   0, 163, 255,   0, 157, 255,   0,
+    151, 255,   0, 145, 255,   0, 139, 255,   0, 133, 255,   0,
+    127, 255,   0, 121, 255,   0, 115, 255,   0, 109, 255,   0,
+    103, 255,   0,  97, 255,   0,  91, 255,   0,  85, 255,   0,
+     79, 255,   0,  73, 255,   0,  67, 255,   0,  61, 255,   0,
+     55, 255,   0,  49, 255,   0,  43, 255,   0,  37, 255,   0,
+     31, 255,   0,  25, 255,   0,  19, 255,   0,  13, 255,   0,
+      7, 255,   0,   1, 255,   0,   0, 255,   4,   0, 255,  10,
+      0, 255,  16,   0, 255,  22,   0, 255,  28,   0, 255,  34,
+      0, 255,  40,   0, 255,  46,   0, 255,  52,   0, 255,  58,
+      0, 255,  64,   0, 255,  70,   0, 255,  76,   0, 255,  82,
+      0, 255,  88,   0, 255,  94,   0, 255, 100,   0, 255, 106,
+      0, 255, 112,   0, 255, 118,   0, 255, 124,   0, 255, 130,
+      0, 255, 136,   0, 255, 142,   0, 255, 148,   0, 255, 154,
+      0, 255, 160,   0, 255, 166,   0, 255, 172,   0, 255, 178,
+      0, 255, 184,   0, 255, 190,   0, 255, 196,   0, 255, 202,
+      0, 255, 208,   0, 255, 214,   0, 255, 220,   0, 255, 226,
+      0, 255, 232,   0, 255, 238,   0, 255, 244,   0, 255, 250,
+      0, 255, 255,   0, 249, 255,   0, 243, 255,   0, 237, 255,
+      0, 231, 255,   0, 225, 255,   0, 219, 255,   0, 213, 255,
+      0, 207, 255,   0, 201, 255,   0, 195, 255,   0, 189, 255,
+      0, 183, 255,   0, 177, 255,   0, 171, 255,   0, 165, 255,
+      0, 159, 255,   0, 153, 255,   0, 147, 255,   0, 141, 255,
+      0, 135, 255,   0, 129, 255,   0, 123, 255,   0, 117, 255,
+      0, 111, 255,   0, 105, 255,   0,  99, 255,   0,  93, 255,
+      0,  87, 255,   0,  81, 255,   0,  75, 255,   0,  69, 255,
+      0,  63, 255,   0,  57, 255,   0,  51, 255,   0,  45, 255,
+      0,  39, 255,   0,  33, 255,   0,  27, 255,   0,  21, 255,
+      0,  15, 255,   0,   9, 255,   0,   3, 255,   2,   0, 255,
+      8,   0, 255,  14,   0, 255,  20,   0, 255,  26,   0, 255,
+     32,   0, 255,  38,   0, 255,  44,   0, 255,  50,   0, 255,
+     56,   0, 255,  62,   0, 255,  68,   0, 255,  74,   0, 255,
+     80,   0, 255,  86,   0, 255,  92,   0, 255,  98,   0, 255,
+    104,   0, 255, 110,   0, 255, 116,   0, 255, 122,   0, 255,
+    128,   0, 255, 134,   0, 255, 140,   0, 255, 146,   0, 255,
+    152,   0, 255, 158,   0, 255, 164,   0, 255, 170,   0, 255,
+    176,   0, 255, 182,   0, 255, 188,   0, 255, 194,   0, 255,
+    200,   0, 255, 206,   0, 255, 212,   0, 255, 218,   0, 255,
+    224,   0, 255, 230,   0, 255, 236,   0, 255, 242,   0, 255,
+    248,   0, 255, 254,   0, 255, 255,   0, 251, 255,   0, 245,
+    255,   0, 239, 255,   0, 233, 255,   0, 227, 255,   0, 221,
+    255,   0, 215, 255,   0, 209, 255,   0, 203, 255,   0, 197,
+    255,   0, 191, 255,   0, 185, 255,   0, 179, 255,   0, 173,
+    255,   0, 167, 255,   0, 161, 255,   0, 155, 255,   0, 149,
+    255,   0, 143, 255,   0, 137, 255,   0, 131, 255,   0, 125,
+    255,   0, 119, 255,   0, 113, 255,   0, 107, 255,   0, 101,
+    255,   0,  95, 255,   0,  89, 255,   0,  83, 255,   0,  77,
+    255,   0,  71, 255,   0,  65, 255,   0,  59, 255,   0,  53,
+    255,   0,  47, 255,   0,  41, 255,   0,  35, 255,   0,  29,
+    255,   0,  23, 255,   0,  17, 255,   0,  11, 255,   0,   5
+};
@@ -0,0 +1,42 @@
+/*-------------------------------------------------------------------------
+NeoHueTable provides the fully saturated colors of the 8 bit hues
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+#pragma once
+
+// NeoHueTable maps an 8 bit hue, where 256 would be a full turn of the
+// wheel, to its fully saturated and fully bright color, so the integer
+// color objects need no segment math per pixel; it uses 768 bytes
+class NeoHueTable
+{
+public:
+    // the R, G and B of the hue
+    static const uint8_t* Color(uint8_t hue)
+    {
+        return _table + hue * 3;
+    }
+
+private:
+    static const uint8_t _table[256 * 3];
+};
@@ -0,0 +1,146 @@
+/*-------------------------------------------------------------------------
+NeoOutputScale provides the helpers methods use to scale the pixel data
+as they encode it for the wire.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+// a scale is 8.8 fixed point, 256 sends the data unchanged; it matches
+// the ColorObject Dim(ratio) of the features with scale = ratio + 1
+const uint16_t NeoOutputScaleNone = 256;
+
+// the stack buffer methods scale through, in bytes
+const size_t NeoOutputScaleChunkSize = 64;
+
+inline uint8_t NeoScaleByte(uint8_t value, uint16_t scale)
+{
+    return static_cast<uint8_t>((static_cast<uint16_t>(value) * scale) >> 8);
+}
+
+inline void NeoScaleBytes(uint8_t* pDest, const uint8_t* pSrc, size_t count, uint16_t scale)
+{
+    const uint8_t* pEnd = pSrc + count;
+
+    while (pSrc < pEnd)
+    {
+        *(pDest++) = NeoScaleByte(*(pSrc++), scale);
+    }
+}
+
+// calls fnEncode(offset, pBytes, count) over count bytes of pData from
+// offset on; the bytes past sizeSettings are scaled through a stack
+// buffer first, the settings in front of the pixels never are
+template <typename T_ENCODE> void NeoEncodeScaled(const uint8_t* pData,
+    size_t offset,
+    size_t count,
+    size_t sizeSettings,
+    uint16_t scale,
+    T_ENCODE fnEncode)
+{
+    size_t end = offset + count;
+
+    if (scale == NeoOutputScaleNone)
+    {
+        fnEncode(offset, pData + offset, count);
+        return;
+    }
+
+    if (offset < sizeSettings)
+    {
+        size_t countSettings = ((end < sizeSettings) ? end : sizeSettings) - offset;
+
+        fnEncode(offset, pData + offset, countSettings);
+        offset += countSettings;
+    }
+
+    uint8_t scaled[NeoOutputScaleChunkSize];
+
+    while (offset < end)
+    {
+        size_t countChunk = end - offset;
+        if (countChunk > sizeof(scaled))
+        {
+            countChunk = sizeof(scaled);
+        }
+
+        NeoScaleBytes(scaled, pData + offset, countChunk, scale);
+        fnEncode(offset, scaled, countChunk);
+        offset += countChunk;
+    }
+}
+
+// as NeoEncodeScaled, for methods that send the pixels rotated: the pixel
+// byte at sizeSettings + rotation is sent first and the ones in front of
+// it wrap around to the end, so fnEncode gets the offset the bytes are
+// sent at rather than the offset they are stored at
+template <typename T_ENCODE> void NeoEncodeRotated(const uint8_t* pData,
+    size_t offset,
+    size_t count,
+    size_t sizeData,
+    size_t sizeSettings,
+    size_t rotation,
+    uint16_t scale,
+    T_ENCODE fnEncode)
+{
+    size_t end = offset + count;
+    size_t split = sizeSettings + rotation;
+
+    if (rotation == 0)
+    {
+        NeoEncodeScaled(pData, offset, count, sizeSettings, scale, fnEncode);
+        return;
+    }
+
+    if (offset < sizeSettings)
+    {
+        size_t countSettings = ((end < sizeSettings) ? end : sizeSettings) - offset;
+
+        fnEncode(offset, pData + offset, countSettings);
+        offset += countSettings;
+    }
+
+    if (offset < split && offset < end)
+    {
+        // the front of the pixels is sent after the back
+        size_t endFront = (end < split) ? end : split;
+        size_t wrap = sizeData - split;
+
+        NeoEncodeScaled(pData, offset, endFront - offset, sizeSettings, scale,
+            [&fnEncode, wrap](size_t offsetData, const uint8_t* pBytes, size_t countBytes)
+            {
+                fnEncode(offsetData + wrap, pBytes, countBytes);
+            });
+        offset = endFront;
+    }
+
+    if (offset < end)
+    {
+        NeoEncodeScaled(pData, offset, end - offset, sizeSettings, scale,
+            [&fnEncode, rotation](size_t offsetData, const uint8_t* pBytes, size_t countBytes)
+            {
+                fnEncode(offsetData - rotation, pBytes, countBytes);
+            });
+    }
+}
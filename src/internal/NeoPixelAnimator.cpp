@@ -27,14 +27,26 @@ License along with NeoPixel.  If not, see
 #include "NeoPixelBus.h"
 #include "NeoPixelAnimator.h"
 
-NeoPixelAnimator::NeoPixelAnimator(uint16_t countAnimations, uint16_t timeScale) :
+NeoPixelAnimator::NeoPixelAnimator(uint16_t countAnimations, uint16_t timeScale, NeoAnimatorClock clock) :
     _countAnimations(countAnimations),
     _animationLastTick(0),
     _activeAnimations(0),
-    _isRunning(true)
+    _clock(clock),
+    _isRunning(true),
+    _isUpdating(false)
 {
     setTimeScale(timeScale);
     _animations = new AnimationContext[_countAnimations];
+
+    _scheduled.first = NoAnimation;
+    _scheduled.last = NoAnimation;
+    _free.first = NoAnimation;
+    _free.last = NoAnimation;
+
+    for (uint16_t indexAnimation = 0; indexAnimation < _countAnimations; indexAnimation++)
+    {
+        _linkBack(&_free, indexAnimation);
+    }
 }
 
 NeoPixelAnimator::~NeoPixelAnimator()
@@ -50,25 +62,40 @@ bool NeoPixelAnimator::NextAvailableAnimation(uint16_t* indexAvailable, uint16_t
         indexStart = _countAnimations - 1;
     }
 
+    // the one asked for when it's free, otherwise any free one
     uint16_t next = indexStart;
 
-    do
+    if (IsAnimationActive(next))
+    {
+        next = _free.first;
+    }
+
+    if (next == NoAnimation)
     {
-        if (!IsAnimationActive(next))
+        // animations stopped since the last update are only put on the
+        // free list by it, so search for one of them
+        next = indexStart;
+
+        do
         {
-            if (indexAvailable)
-            {
-                *indexAvailable = next;
-            }
-            return true;
+            next = (next + 1) % _countAnimations;
+        } while (next != indexStart && IsAnimationActive(next));
+
+        if (next == indexStart)
+        {
+            return false;
         }
-        next = (next + 1) % _countAnimations;
-    } while (next != indexStart);
-    return false;
+    }
+
+    if (indexAvailable)
+    {
+        *indexAvailable = next;
+    }
+    return true;
 }
 
 void NeoPixelAnimator::StartAnimation(uint16_t indexAnimation, 
-        uint16_t duration, 
+        uint32_t duration, 
         AnimUpdateCallback animUpdate)
 {
     if (indexAnimation >= _countAnimations || animUpdate == NULL)
@@ -76,9 +103,11 @@ void NeoPixelAnimator::StartAnimation(uint16_t indexAnimation,
         return;
     }
 
-    if (_activeAnimations == 0)
+    // during an update the last tick was just moved up to now, less the
+    // part of a unit kept for the next update, which a reset would drop
+    if (_activeAnimations == 0 && !_isUpdating)
     {
-        _animationLastTick = millis();
+        _animationLastTick = _currentTick();
     }
 
     StopAnimation(indexAnimation);
@@ -90,7 +119,16 @@ void NeoPixelAnimator::StartAnimation(uint16_t indexAnimation,
         duration = 1;
     }
 
-    _animations[indexAnimation].StartAnimation(duration, animUpdate);
+    AnimationContext* pAnim = &_animations[indexAnimation];
+
+    pAnim->StartAnimation(duration, animUpdate);
+
+    if (!pAnim->_isScheduled)
+    {
+        _unlink(&_free, indexAnimation);
+        _linkBack(&_scheduled, indexAnimation);
+        pAnim->_isScheduled = true;
+    }
 
     _activeAnimations++;
 }
@@ -111,7 +149,8 @@ void NeoPixelAnimator::StopAnimation(uint16_t indexAnimation)
 
 void NeoPixelAnimator::StopAll()
 {
-    for (uint16_t indexAnimation = 0; indexAnimation < _countAnimations; ++indexAnimation)
+    // every animation with time left is scheduled
+    for (uint16_t indexAnimation = _scheduled.first; indexAnimation != NoAnimation; indexAnimation = _animations[indexAnimation]._next)
     {
         _animations[indexAnimation].StopAnimation();
     }
@@ -123,8 +162,7 @@ void NeoPixelAnimator::UpdateAnimations()
 {
     if (_isRunning)
     {
-        uint32_t currentTick = millis();
-        uint32_t delta = currentTick - _animationLastTick;
+        uint32_t delta = _currentTick() - _animationLastTick;
 
         if (delta >= _timeScale)
         {
@@ -132,7 +170,19 @@ void NeoPixelAnimator::UpdateAnimations()
 
             delta /= _timeScale; // scale delta into animation time
 
-            for (uint16_t iAnim = 0; iAnim < _countAnimations; iAnim++)
+            // only the whole units are used up, the part of a unit left
+            // over counts toward the next update, so no time is lost
+            _animationLastTick += delta * _timeScale;
+
+            // animations started by the callbacks are added after the
+            // last and wait for the next update, as none of delta
+            // passed for them
+            uint16_t iLast = _scheduled.last;
+            uint16_t iAnim = _scheduled.first;
+
+            _isUpdating = true;
+
+            while (iAnim != NoAnimation)
             {
                 pAnim = &_animations[iAnim];
                 AnimUpdateCallback fnUpdate = pAnim->_fnCallback;
@@ -142,15 +192,19 @@ void NeoPixelAnimator::UpdateAnimations()
 
                 if (pAnim->_remaining > delta)
                 {
-                    param.state = (pAnim->_remaining == pAnim->_duration) ? AnimationState_Started : AnimationState_Progress;
+                    param.state = pAnim->_isStarting ? AnimationState_Started : AnimationState_Progress;
                     param.progress = pAnim->CurrentProgress();
 
-                    fnUpdate(param);
-
+                    // before the callback, which may stop or restart it
                     pAnim->_remaining -= delta;
+                    pAnim->_isStarting = false;
+
+                    fnUpdate(param);
                 }
                 else if (pAnim->_remaining > 0)
                 {
+                    uint32_t leftover = delta - pAnim->_remaining;
+
                     param.state = AnimationState_Completed;
                     param.progress = 1.0f;
 
@@ -158,15 +212,37 @@ void NeoPixelAnimator::UpdateAnimations()
                     pAnim->StopAnimation();
 
                     fnUpdate(param);
+
+                    // restarted from its own callback, so a loop; the units
+                    // past the end count toward the next pass so it keeps
+                    // in phase with the clock, though it always has one
+                    // unit left for an update to complete it
+                    if (pAnim->_remaining != 0)
+                    {
+                        pAnim->_remaining = (pAnim->_remaining > leftover) ? pAnim->_remaining - leftover : 1;
+                    }
+                }
+
+                // read after the callback, which may have added to the end
+                uint16_t iNext = (iAnim == iLast) ? NoAnimation : pAnim->_next;
+
+                // stopped here or since the last update, and not restarted
+                if (pAnim->_remaining == 0)
+                {
+                    _unlink(&_scheduled, iAnim);
+                    _linkFront(&_free, iAnim);
+                    pAnim->_isScheduled = false;
                 }
+
+                iAnim = iNext;
             }
 
-            _animationLastTick = currentTick;
+            _isUpdating = false;
         }
     }
 }
 
-void NeoPixelAnimator::ChangeAnimationDuration(uint16_t indexAnimation, uint16_t newDuration)
+void NeoPixelAnimator::ChangeAnimationDuration(uint16_t indexAnimation, uint32_t newDuration)
 {
     if (indexAnimation >= _countAnimations)
     {
@@ -175,23 +251,91 @@ void NeoPixelAnimator::ChangeAnimationDuration(uint16_t indexAnimation, uint16_t
 
     AnimationContext* pAnim = &_animations[indexAnimation];
 
-    // calc the current animation progress 
-    float progress = pAnim->CurrentProgress();
+    // as in StartAnimation, a zero duration would read as stopped
+    if (newDuration == 0)
+    {
+        newDuration = 1;
+    }
+
+    // _remaining time must also be reset after a duration change;
+    // scale it so the progress stays the same, in integers as a float
+    // can't hold every 32 bit duration
+    uint32_t remaining = 0;
 
-    // keep progress in range just in case
-    if (progress < 0.0f)
+    if (pAnim->_duration != 0)
     {
-        progress = 0.0f;
+        remaining = static_cast<uint32_t>(static_cast<uint64_t>(newDuration) * pAnim->_remaining / pAnim->_duration);
     }
-    else if (progress > 1.0f)
+
+    // an active animation stays active until an update completes it
+    if (pAnim->_remaining != 0 && remaining == 0)
     {
-        progress = 1.0f;
+        remaining = 1;
     }
 
     // change the duration 
     pAnim->_duration = newDuration;
-          
-    // _remaining time must also be reset after a duration change; 
-    // use the progress to recalculate it
-    pAnim->_remaining = uint16_t(pAnim->_duration * (1.0f - progress));
-}
\ No newline at end of file
+    pAnim->_remaining = remaining;
+}
+
+void NeoPixelAnimator::_unlink(AnimationList* pList, uint16_t indexAnimation)
+{
+    AnimationContext* pAnim = &_animations[indexAnimation];
+
+    if (pAnim->_prev == NoAnimation)
+    {
+        pList->first = pAnim->_next;
+    }
+    else
+    {
+        _animations[pAnim->_prev]._next = pAnim->_next;
+    }
+
+    if (pAnim->_next == NoAnimation)
+    {
+        pList->last = pAnim->_prev;
+    }
+    else
+    {
+        _animations[pAnim->_next]._prev = pAnim->_prev;
+    }
+
+    pAnim->_prev = NoAnimation;
+    pAnim->_next = NoAnimation;
+}
+
+void NeoPixelAnimator::_linkFront(AnimationList* pList, uint16_t indexAnimation)
+{
+    AnimationContext* pAnim = &_animations[indexAnimation];
+
+    pAnim->_prev = NoAnimation;
+    pAnim->_next = pList->first;
+
+    if (pList->first == NoAnimation)
+    {
+        pList->last = indexAnimation;
+    }
+    else
+    {
+        _animations[pList->first]._prev = indexAnimation;
+    }
+    pList->first = indexAnimation;
+}
+
+void NeoPixelAnimator::_linkBack(AnimationList* pList, uint16_t indexAnimation)
+{
+    AnimationContext* pAnim = &_animations[indexAnimation];
+
+    pAnim->_prev = pList->last;
+    pAnim->_next = NoAnimation;
+
+    if (pList->last == NoAnimation)
+    {
+        pList->first = indexAnimation;
+    }
+    else
+    {
+        _animations[pList->last]._next = indexAnimation;
+    }
+    pList->last = indexAnimation;
+}
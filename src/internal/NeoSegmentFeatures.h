@@ -42,33 +42,22 @@ public:
 
     static void replicatePixel(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            for (uint8_t iElement = 0; iElement < PixelSize; iElement++)
-            {
-                *pPixelDest++ = pPixelSrc[iElement];
-            }
-        }
+        NeoElementsCopy<PixelSize>::replicatePixel(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsInc(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pEnd = pPixelDest + (count * PixelSize);
-        while (pPixelDest < pEnd)
-        {
-            *pPixelDest++ = *pPixelSrc++;
-        }
+        NeoElementsCopy<PixelSize>::movePixelsInc(pPixelDest, pPixelSrc, count);
     }
 
     static void movePixelsDec(uint8_t* pPixelDest, const uint8_t* pPixelSrc, uint16_t count)
     {
-        uint8_t* pDestBack = pPixelDest + (count * PixelSize);
-        const uint8_t* pSrcBack = pPixelSrc + (count * PixelSize);
-        while (pDestBack > pPixelDest)
-        {
-            *--pDestBack = *--pSrcBack;
-        }
+        NeoElementsCopy<PixelSize>::movePixelsDec(pPixelDest, pPixelSrc, count);
+    }
+
+    static void rotatePixelsLeft(uint8_t* pPixels, uint16_t count, uint16_t rotationCount)
+    {
+        NeoElementsCopy<PixelSize>::rotatePixelsLeft(pPixels, count, rotationCount);
     }
 
     typedef SevenSegDigit ColorObject;
@@ -0,0 +1,62 @@
+/*-------------------------------------------------------------------------
+NeoShowComplete provides the completion callback used by
+NeoPixelBus::ShowAsync and ready made callbacks for it.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include "NeoShowComplete.h"
+
+#if !defined(IRAM_ATTR)
+#define IRAM_ATTR
+#endif
+
+void IRAM_ATTR NeoShowCompleteSetFlag(void* context)
+{
+    *static_cast<volatile bool*>(context) = true;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+void IRAM_ATTR NeoShowCompleteNotifyTask(void* context)
+{
+    TaskHandle_t task = static_cast<TaskHandle_t>(context);
+
+    if (xPortInIsrContext())
+    {
+        BaseType_t taskWoken = pdFALSE;
+
+        vTaskNotifyGiveFromISR(task, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+    }
+    else
+    {
+        xTaskNotifyGive(task);
+    }
+}
+
+#endif
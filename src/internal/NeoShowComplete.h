@@ -0,0 +1,41 @@
+/*-------------------------------------------------------------------------
+NeoShowComplete provides the completion callback used by
+NeoPixelBus::ShowAsync and ready made callbacks for it.
+
+Written by Michael C. Miller.
+
+I invest time and resources providing this open source code,
+please support me by dontating (see https://github.com/Makuna/NeoPixelBus)
+
+-------------------------------------------------------------------------
+This file is part of the Makuna/NeoPixelBus library.
+
+NeoPixelBus is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+NeoPixelBus is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with NeoPixel.  If not, see
+<http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------*/
+
+#pragma once
+
+// called once when the send started by ShowAsync is done; on methods that
+// signal completion from an interrupt it runs in that interrupt, so it must
+// be short and, on the ESP32 and ESP8266, placed in IRAM
+typedef void(*NeoShowCompleteCallback)(void* context);
+
+// context is a volatile bool that gets set to true
+void NeoShowCompleteSetFlag(void* context);
+
+#if defined(ARDUINO_ARCH_ESP32)
+// context is the TaskHandle_t of a task that waits with ulTaskNotifyTake
+void NeoShowCompleteNotifyTask(void* context);
+#endif
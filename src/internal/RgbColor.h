@@ -33,6 +33,8 @@ License along with NeoPixel.  If not, see
 
 struct HslColor;
 struct HsbColor;
+struct HslColor8;
+struct HsbColor8;
 
 // ------------------------------------------------------------------------
 // RgbColor represents a color object that is represented by Red, Green, Blue
@@ -75,6 +77,16 @@ struct RgbColor
     // ------------------------------------------------------------------------
     constexpr RgbColor(const HsbColor& color);
 
+    // ------------------------------------------------------------------------
+    // Construct a RgbColor using HslColor8, without floating point
+    // ------------------------------------------------------------------------
+    RgbColor(const HslColor8& color);
+
+    // ------------------------------------------------------------------------
+    // Construct a RgbColor using HsbColor8, without floating point
+    // ------------------------------------------------------------------------
+    RgbColor(const HsbColor8& color);
+
     // ------------------------------------------------------------------------
     // Comparison operators
     // ------------------------------------------------------------------------
@@ -127,6 +139,20 @@ struct RgbColor
     // ------------------------------------------------------------------------
     static constexpr RgbColor LinearBlend(const RgbColor& left, const RgbColor& right, float progress);
 
+    // ------------------------------------------------------------------------
+    // LinearBlend8 and LinearBlend16 blend between two colors using only
+    // integer math, for platforms without a floating point unit; the result
+    // is within 1 of LinearBlend at progress / 255.0f or progress / 65535.0f.
+    // They are named by their width so a literal progress can't pick the
+    // wrong one
+    // left - the color to start the blend at
+    // right - the color to end the blend at
+    // progress - (0 - 255) or (0 - 65535) value where 0 will return left and
+    //     the maximum will return right
+    // ------------------------------------------------------------------------
+    static constexpr RgbColor LinearBlend8(const RgbColor& left, const RgbColor& right, uint8_t progress);
+    static constexpr RgbColor LinearBlend16(const RgbColor& left, const RgbColor& right, uint16_t progress);
+
     // ------------------------------------------------------------------------
     // BilinearBlend between four colors by the amount defined by 2d variable
     // c00 - upper left quadrant color
@@ -143,6 +169,28 @@ struct RgbColor
         float x,
         float y);
 
+    // ------------------------------------------------------------------------
+    // BilinearBlend8 and BilinearBlend16 blend between four colors using
+    // only integer math; the result is within 1 of BilinearBlend at
+    // x / 255.0f, y / 255.0f or x / 65535.0f, y / 65535.0f
+    // x - (0 - 255) or (0 - 65535) value that defines the blend progress in
+    //     horizontal space
+    // y - (0 - 255) or (0 - 65535) value that defines the blend progress in
+    //     vertical space
+    // ------------------------------------------------------------------------
+    static constexpr RgbColor BilinearBlend8(const RgbColor& c00,
+        const RgbColor& c01,
+        const RgbColor& c10,
+        const RgbColor& c11,
+        uint8_t x,
+        uint8_t y);
+    static constexpr RgbColor BilinearBlend16(const RgbColor& c00,
+        const RgbColor& c01,
+        const RgbColor& c10,
+        const RgbColor& c11,
+        uint16_t x,
+        uint16_t y);
+
     constexpr uint32_t CalcTotalTenthMilliAmpere(const SettingsObject& settings) const;
 
     // ------------------------------------------------------------------------
@@ -156,6 +204,16 @@ struct RgbColor
 private:
     inline static constexpr uint8_t _elementDim(uint8_t value, uint8_t ratio);
     inline static constexpr uint8_t _elementBrighten(uint8_t value, uint8_t ratio);
+    inline static constexpr uint16_t _blendWeight(uint8_t progress);
+    inline static constexpr uint32_t _blendWeight(uint16_t progress);
+    inline static constexpr uint8_t _elementLinearBlend(uint8_t left, uint8_t right, uint16_t weight);
+    inline static constexpr uint8_t _elementLinearBlend(uint8_t left, uint8_t right, uint32_t weight);
+    inline static constexpr uint8_t _elementBilinearBlend(uint8_t c00,
+        uint8_t c01,
+        uint8_t c10,
+        uint8_t c11,
+        const uint32_t weights[4],
+        uint8_t shift);
     inline static constexpr float _CalcColor(float p, float q, float t);
     inline static constexpr RgbColor convertToRgbColor(const HslColor& color);
     inline static constexpr RgbColor convertToRgbColor(HsbColor color);
@@ -165,6 +223,8 @@ private:
 
 #include "HslColor.h"
 #include "HsbColor.h"
+#include "HslColor8.h"
+#include "HsbColor8.h"
 
 constexpr RgbColor::RgbColor() = default;
 
@@ -302,6 +362,70 @@ constexpr RgbColor RgbColor::BilinearBlend(const RgbColor& c00,
         c00.B * v00 + c10.B * v10 + c01.B * v01 + c11.B * v11);
 }
 
+constexpr RgbColor RgbColor::LinearBlend8(const RgbColor& left, const RgbColor& right, uint8_t progress)
+{
+    uint16_t weight = _blendWeight(progress);
+
+    return RgbColor(
+        _elementLinearBlend(left.R, right.R, weight),
+        _elementLinearBlend(left.G, right.G, weight),
+        _elementLinearBlend(left.B, right.B, weight));
+}
+
+constexpr RgbColor RgbColor::LinearBlend16(const RgbColor& left, const RgbColor& right, uint16_t progress)
+{
+    uint32_t weight = _blendWeight(progress);
+
+    return RgbColor(
+        _elementLinearBlend(left.R, right.R, weight),
+        _elementLinearBlend(left.G, right.G, weight),
+        _elementLinearBlend(left.B, right.B, weight));
+}
+
+constexpr RgbColor RgbColor::BilinearBlend8(const RgbColor& c00,
+    const RgbColor& c01,
+    const RgbColor& c10,
+    const RgbColor& c11,
+    uint8_t x,
+    uint8_t y)
+{
+    // 8.8 weights, so their products are 16.16 and sum to exactly 1.0
+    uint32_t wx = _blendWeight(x);
+    uint32_t wy = _blendWeight(y);
+    const uint32_t weights[4] = {
+        (256 - wx) * (256 - wy),
+        (256 - wx) * wy,
+        wx * (256 - wy),
+        wx * wy };
+
+    return RgbColor(
+        _elementBilinearBlend(c00.R, c01.R, c10.R, c11.R, weights, 16),
+        _elementBilinearBlend(c00.G, c01.G, c10.G, c11.G, weights, 16),
+        _elementBilinearBlend(c00.B, c01.B, c10.B, c11.B, weights, 16));
+}
+
+constexpr RgbColor RgbColor::BilinearBlend16(const RgbColor& c00,
+    const RgbColor& c01,
+    const RgbColor& c10,
+    const RgbColor& c11,
+    uint16_t x,
+    uint16_t y)
+{
+    // the 16 bit weights are cut to 12 bits so their products fit 32 bits
+    uint32_t wx = _blendWeight(x) >> 4;
+    uint32_t wy = _blendWeight(y) >> 4;
+    const uint32_t weights[4] = {
+        (4096 - wx) * (4096 - wy),
+        (4096 - wx) * wy,
+        wx * (4096 - wy),
+        wx * wy };
+
+    return RgbColor(
+        _elementBilinearBlend(c00.R, c01.R, c10.R, c11.R, weights, 24),
+        _elementBilinearBlend(c00.G, c01.G, c10.G, c11.G, weights, 24),
+        _elementBilinearBlend(c00.B, c01.B, c10.B, c11.B, weights, 24));
+}
+
 constexpr uint32_t RgbColor::CalcTotalTenthMilliAmpere(const SettingsObject& settings) const
 {
     auto total = 0;
@@ -333,6 +457,41 @@ constexpr uint8_t RgbColor::_elementBrighten(uint8_t value, uint8_t ratio)
     return element;
 }
 
+// the progress as a weight where the maximum is exactly 1.0, 8.8 for
+// uint8_t and 16.16 for uint16_t
+constexpr uint16_t RgbColor::_blendWeight(uint8_t progress)
+{
+    return static_cast<uint16_t>(progress) + (progress >> 7);
+}
+
+constexpr uint32_t RgbColor::_blendWeight(uint16_t progress)
+{
+    return static_cast<uint32_t>(progress) + (progress >> 15);
+}
+
+constexpr uint8_t RgbColor::_elementLinearBlend(uint8_t left, uint8_t right, uint16_t weight)
+{
+    // 16 bit math, as 255 * 256 fits
+    return (static_cast<uint16_t>(left) * static_cast<uint16_t>(256 - weight) +
+        static_cast<uint16_t>(right) * weight) >> 8;
+}
+
+constexpr uint8_t RgbColor::_elementLinearBlend(uint8_t left, uint8_t right, uint32_t weight)
+{
+    return (static_cast<uint32_t>(left) * (65536 - weight) +
+        static_cast<uint32_t>(right) * weight) >> 16;
+}
+
+constexpr uint8_t RgbColor::_elementBilinearBlend(uint8_t c00,
+    uint8_t c01,
+    uint8_t c10,
+    uint8_t c11,
+    const uint32_t weights[4],
+    uint8_t shift)
+{
+    return (c00 * weights[0] + c01 * weights[1] + c10 * weights[2] + c11 * weights[3]) >> shift;
+}
+
 constexpr float RgbColor::_CalcColor(float p, float q, float t)
 {
     if (t < 0.0f)
@@ -380,58 +539,65 @@ constexpr RgbColor RgbColor::convertToRgbColor(const HslColor& color)
 
 constexpr RgbColor RgbColor::convertToRgbColor(HsbColor color)
 {
-    if (fuzzyCompare(color.S, 0.0f))
-        return RgbColor{uint8_t(color.B), uint8_t(color.B), uint8_t(color.B)}; // achromatic or black
-
-    RgbColor rgb{};
-
-    if (color.H < 0.0f)
-        color.H += 1.0f;
-    else if (color.H >= 1.0f)
-        color.H -= 1.0f;
-
-    color.H *= 6.0f;
-    int i = (int)color.H;
-    float f = color.H - i;
-    float q = color.B * (1.0f - color.S * f);
-    float p = color.B * (1.0f - color.S);
-    float t = color.B * (1.0f - color.S * (1.0f - f));
+    float r{};
+    float g{};
+    float b{};
 
-    switch (i)
+    if (fuzzyCompare(color.S, 0.0f))
     {
-    case 0:
-        rgb.R = color.B;
-        rgb.G = t;
-        rgb.B = p;
-        break;
-    case 1:
-        rgb.R = q;
-        rgb.G = color.B;
-        rgb.B = p;
-        break;
-    case 2:
-        rgb.R = p;
-        rgb.G = color.B;
-        rgb.B = t;
-        break;
-    case 3:
-        rgb.R = p;
-        rgb.G = q;
-        rgb.B = color.B;
-        break;
-    case 4:
-        rgb.R = t;
-        rgb.G = p;
-        rgb.B = color.B;
-        break;
-    default:
-        rgb.R = color.B;
-        rgb.G = p;
-        rgb.B = q;
-        break;
+        r = g = b = color.B; // achromatic or black
+    }
+    else
+    {
+        if (color.H < 0.0f)
+            color.H += 1.0f;
+        else if (color.H >= 1.0f)
+            color.H -= 1.0f;
+
+        color.H *= 6.0f;
+        int i = (int)color.H;
+        float f = color.H - i;
+        float q = color.B * (1.0f - color.S * f);
+        float p = color.B * (1.0f - color.S);
+        float t = color.B * (1.0f - color.S * (1.0f - f));
+
+        switch (i)
+        {
+        case 0:
+            r = color.B;
+            g = t;
+            b = p;
+            break;
+        case 1:
+            r = q;
+            g = color.B;
+            b = p;
+            break;
+        case 2:
+            r = p;
+            g = color.B;
+            b = t;
+            break;
+        case 3:
+            r = p;
+            g = q;
+            b = color.B;
+            break;
+        case 4:
+            r = t;
+            g = p;
+            b = color.B;
+            break;
+        default:
+            r = color.B;
+            g = p;
+            b = q;
+            break;
+        }
     }
 
-    return rgb;
+    // the components are (0.0 - 1.0)
+    return RgbColor{(uint8_t)(r * 255.0f), (uint8_t)(g * 255.0f), (uint8_t)(b * 255.0f)};
 }
 
 constexpr bool RgbColor::fuzzyCompare(double p1, double p2)
@@ -142,6 +142,20 @@ struct RgbwColor
     // ------------------------------------------------------------------------
     static constexpr RgbwColor LinearBlend(const RgbwColor& left, const RgbwColor& right, float progress);
 
+    // ------------------------------------------------------------------------
+    // LinearBlend8 and LinearBlend16 blend between two colors using only
+    // integer math, for platforms without a floating point unit; the result
+    // is within 1 of LinearBlend at progress / 255.0f or progress / 65535.0f.
+    // They are named by their width so a literal progress can't pick the
+    // wrong one
+    // left - the color to start the blend at
+    // right - the color to end the blend at
+    // progress - (0 - 255) or (0 - 65535) value where 0 will return left and
+    //     the maximum will return right
+    // ------------------------------------------------------------------------
+    static constexpr RgbwColor LinearBlend8(const RgbwColor& left, const RgbwColor& right, uint8_t progress);
+    static constexpr RgbwColor LinearBlend16(const RgbwColor& left, const RgbwColor& right, uint16_t progress);
+
     // ------------------------------------------------------------------------
     // BilinearBlend between four colors by the amount defined by 2d variable
     // c00 - upper left quadrant color
@@ -158,6 +172,28 @@ struct RgbwColor
         float x, 
         float y);
 
+    // ------------------------------------------------------------------------
+    // BilinearBlend8 and BilinearBlend16 blend between four colors using
+    // only integer math; the result is within 1 of BilinearBlend at
+    // x / 255.0f, y / 255.0f or x / 65535.0f, y / 65535.0f
+    // x - (0 - 255) or (0 - 65535) value that defines the blend progress in
+    //     horizontal space
+    // y - (0 - 255) or (0 - 65535) value that defines the blend progress in
+    //     vertical space
+    // ------------------------------------------------------------------------
+    static constexpr RgbwColor BilinearBlend8(const RgbwColor& c00,
+        const RgbwColor& c01,
+        const RgbwColor& c10,
+        const RgbwColor& c11,
+        uint8_t x,
+        uint8_t y);
+    static constexpr RgbwColor BilinearBlend16(const RgbwColor& c00,
+        const RgbwColor& c01,
+        const RgbwColor& c10,
+        const RgbwColor& c11,
+        uint16_t x,
+        uint16_t y);
+
     constexpr uint16_t CalcTotalTenthMilliAmpere(const SettingsObject& settings) const;
 
     // ------------------------------------------------------------------------
@@ -173,6 +209,16 @@ struct RgbwColor
 private:
     inline static constexpr uint8_t _elementDim(uint8_t value, uint8_t ratio);
     inline static constexpr uint8_t _elementBrighten(uint8_t value, uint8_t ratio);
+    inline static constexpr uint16_t _blendWeight(uint8_t progress);
+    inline static constexpr uint32_t _blendWeight(uint16_t progress);
+    inline static constexpr uint8_t _elementLinearBlend(uint8_t left, uint8_t right, uint16_t weight);
+    inline static constexpr uint8_t _elementLinearBlend(uint8_t left, uint8_t right, uint32_t weight);
+    inline static constexpr uint8_t _elementBilinearBlend(uint8_t c00,
+        uint8_t c01,
+        uint8_t c10,
+        uint8_t c11,
+        const uint32_t weights[4],
+        uint8_t shift);
 };
 
 #include "RgbColor.h"
@@ -366,6 +412,74 @@ constexpr RgbwColor RgbwColor::BilinearBlend(const RgbwColor& c00,
         c00.W * v00 + c10.W * v10 + c01.W * v01 + c11.W * v11 );
 }
 
+constexpr RgbwColor RgbwColor::LinearBlend8(const RgbwColor& left, const RgbwColor& right, uint8_t progress)
+{
+    uint16_t weight = _blendWeight(progress);
+
+    return RgbwColor(
+        _elementLinearBlend(left.R, right.R, weight),
+        _elementLinearBlend(left.G, right.G, weight),
+        _elementLinearBlend(left.B, right.B, weight),
+        _elementLinearBlend(left.W, right.W, weight));
+}
+
+constexpr RgbwColor RgbwColor::LinearBlend16(const RgbwColor& left, const RgbwColor& right, uint16_t progress)
+{
+    uint32_t weight = _blendWeight(progress);
+
+    return RgbwColor(
+        _elementLinearBlend(left.R, right.R, weight),
+        _elementLinearBlend(left.G, right.G, weight),
+        _elementLinearBlend(left.B, right.B, weight),
+        _elementLinearBlend(left.W, right.W, weight));
+}
+
+constexpr RgbwColor RgbwColor::BilinearBlend8(const RgbwColor& c00,
+    const RgbwColor& c01,
+    const RgbwColor& c10,
+    const RgbwColor& c11,
+    uint8_t x,
+    uint8_t y)
+{
+    // 8.8 weights, so their products are 16.16 and sum to exactly 1.0
+    uint32_t wx = _blendWeight(x);
+    uint32_t wy = _blendWeight(y);
+    const uint32_t weights[4] = {
+        (256 - wx) * (256 - wy),
+        (256 - wx) * wy,
+        wx * (256 - wy),
+        wx * wy };
+
+    return RgbwColor(
+        _elementBilinearBlend(c00.R, c01.R, c10.R, c11.R, weights, 16),
+        _elementBilinearBlend(c00.G, c01.G, c10.G, c11.G, weights, 16),
+        _elementBilinearBlend(c00.B, c01.B, c10.B, c11.B, weights, 16),
+        _elementBilinearBlend(c00.W, c01.W, c10.W, c11.W, weights, 16));
+}
+
+constexpr RgbwColor RgbwColor::BilinearBlend16(const RgbwColor& c00,
+    const RgbwColor& c01,
+    const RgbwColor& c10,
+    const RgbwColor& c11,
+    uint16_t x,
+    uint16_t y)
+{
+    // the 16 bit weights are cut to 12 bits so their products fit 32 bits
+    uint32_t wx = _blendWeight(x) >> 4;
+    uint32_t wy = _blendWeight(y) >> 4;
+    const uint32_t weights[4] = {
+        (4096 - wx) * (4096 - wy),
+        (4096 - wx) * wy,
+        wx * (4096 - wy),
+        wx * wy };
+
+    return RgbwColor(
+        _elementBilinearBlend(c00.R, c01.R, c10.R, c11.R, weights, 24),
+        _elementBilinearBlend(c00.G, c01.G, c10.G, c11.G, weights, 24),
+        _elementBilinearBlend(c00.B, c01.B, c10.B, c11.B, weights, 24),
+        _elementBilinearBlend(c00.W, c01.W, c10.W, c11.W, weights, 24));
+}
+
 constexpr uint16_t RgbwColor::CalcTotalTenthMilliAmpere(const SettingsObject& settings) const
 {
     auto total = 0;
@@ -397,3 +511,38 @@ constexpr uint8_t RgbwColor::_elementBrighten(uint8_t value, uint8_t ratio)
     }
     return element;
 }
+
+// the progress as a weight where the maximum is exactly 1.0, 8.8 for
+// uint8_t and 16.16 for uint16_t
+constexpr uint16_t RgbwColor::_blendWeight(uint8_t progress)
+{
+    return static_cast<uint16_t>(progress) + (progress >> 7);
+}
+
+constexpr uint32_t RgbwColor::_blendWeight(uint16_t progress)
+{
+    return static_cast<uint32_t>(progress) + (progress >> 15);
+}
+
+constexpr uint8_t RgbwColor::_elementLinearBlend(uint8_t left, uint8_t right, uint16_t weight)
+{
+    // 16 bit math, as 255 * 256 fits
+    return (static_cast<uint16_t>(left) * static_cast<uint16_t>(256 - weight) +
+        static_cast<uint16_t>(right) * weight) >> 8;
+}
+
+constexpr uint8_t RgbwColor::_elementLinearBlend(uint8_t left, uint8_t right, uint32_t weight)
+{
+    return (static_cast<uint32_t>(left) * (65536 - weight) +
+        static_cast<uint32_t>(right) * weight) >> 16;
+}
+
+constexpr uint8_t RgbwColor::_elementBilinearBlend(uint8_t c00,
+    uint8_t c01,
+    uint8_t c10,
+    uint8_t c11,
+    const uint32_t weights[4],
+    uint8_t shift)
+{
+    return (c00 * weights[0] + c01 * weights[1] + c10 * weights[2] + c11 * weights[3]) >> shift;
+}